@@ -0,0 +1,181 @@
+/*
+ * Minimal Arduino core for host-native builds (env:native)
+ * Provides just enough of the arduino-esp32 API for the effect engine, JSON API and their host tests
+ * to compile and run on a PC. Hardware access (GPIO, RMT, WiFi, flash) is stubbed out.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <assert.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "pgmspace.h"
+#include "esp_host.h"   // FreeRTOS, heap_caps and other ESP-IDF pieces
+
+typedef uint8_t  byte;
+typedef bool     boolean;
+typedef uint16_t word;
+inline uint16_t makeWord(uint16_t w) { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+using std::min;
+using std::max;
+// size_t is 32 bit on the ESP32, so mixing it with unsigned is legal there: allow mixed types on the host
+template<typename T, typename U, typename = typename std::enable_if<!std::is_same<T, U>::value>::type>
+constexpr typename std::common_type<T, U>::type min(const T &a, const U &b) { return b < a ? b : a; }
+template<typename T, typename U, typename = typename std::enable_if<!std::is_same<T, U>::value>::type>
+constexpr typename std::common_type<T, U>::type max(const T &a, const U &b) { return a < b ? b : a; }
+using std::abs;
+using std::isinf;
+using std::isnan;
+using ::round;
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT          0x01
+#define OUTPUT         0x03
+#define PULLUP         0x04
+#define INPUT_PULLUP   0x05
+#define PULLDOWN       0x08
+#define INPUT_PULLDOWN 0x09
+#define OPEN_DRAIN     0x10
+#define OUTPUT_OPEN_DRAIN 0x12
+#define ANALOG         0xC0
+#define RISING  0x01
+#define FALLING 0x02
+#define CHANGE  0x03
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#ifndef M_TWOPI
+#define M_TWOPI    6.283185307179586476925286766559
+#endif
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+#define sq(x) ((x)*(x))
+#define _min(a,b) ((a)<(b)?(a):(b))
+#define _max(a,b) ((a)>(b)?(a):(b))
+#define lowByte(w)  ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit)  (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit)   ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#ifndef bit
+#define bit(b) (1UL << (b))
+#endif
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+#define RTC_DATA_ATTR
+#define RTC_NOINIT_ATTR
+#define WORD_ALIGNED_ATTR __attribute__((aligned(4)))
+#define NOINLINE __attribute__((noinline))
+#define ICACHE_RAM_ATTR
+#define ESP_PLATFORM 1
+#ifndef ESP_IDF_VERSION_MAJOR
+  #define ESP_IDF_VERSION_MAJOR 4
+  #define ESP_IDF_VERSION_MINOR 4
+  #define ESP_IDF_VERSION_PATCH 7
+  #define ESP_IDF_VERSION_VAL(major, minor, patch) ((major << 16) | (minor << 8) | (patch))
+  #define ESP_IDF_VERSION ESP_IDF_VERSION_VAL(ESP_IDF_VERSION_MAJOR, ESP_IDF_VERSION_MINOR, ESP_IDF_VERSION_PATCH)
+#endif
+
+// time
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+// host only: advance millis()/micros() without sleeping (benchmarks and tests run on simulated time if enabled)
+void hostSetSimulatedTime(bool enable);
+void hostAdvanceTime(uint32_t us);
+
+// GPIO (no-ops)
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int  digitalRead(uint8_t) { return LOW; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+inline void analogWrite(uint8_t, int) {}
+inline uint32_t analogReadMilliVolts(uint8_t) { return 0; }
+inline void analogReadResolution(uint8_t) {}
+inline void attachInterrupt(uint8_t, void (*)(void), int) {}
+inline void detachInterrupt(uint8_t) {}
+inline uint8_t digitalPinToInterrupt(uint8_t p) { return p; }
+inline unsigned long pulseIn(uint8_t, uint8_t, unsigned long = 1000000L) { return 0; }
+inline uint8_t shiftIn(uint8_t, uint8_t, uint8_t) { return 0; }
+inline void shiftOut(uint8_t, uint8_t, uint8_t, uint8_t) {}
+inline uint16_t touchRead(uint8_t) { return 0; }
+inline bool ledcAttach(uint8_t, uint32_t, uint8_t) { return true; }
+inline uint32_t ledcSetup(uint8_t, uint32_t, uint8_t) { return 1; }
+inline void ledcAttachPin(uint8_t, uint8_t) {}
+inline void ledcDetachPin(uint8_t) {}
+inline void ledcWrite(uint8_t, uint32_t) {}
+typedef int gpio_num_t;
+inline void gpio_reset_pin(int) {}
+inline void gpio_hold_en(gpio_num_t) {}
+inline void gpio_hold_dis(gpio_num_t) {}
+#define digitalPinIsValid(p) ((p) >= 0 && (p) < 40)
+#define digitalPinCanOutput(p) ((p) >= 0 && (p) < 34)
+#define digitalPinToAnalogChannel(p) (-1)
+#define digitalPinToTouchChannel(p) (-1)
+#define GPIO_PIN_COUNT 40
+#define SDA 21
+#define SCL 22
+#define MOSI 23
+#define MISO 19
+#define SCK 18
+#define SS 5
+
+// random
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+uint32_t esp_random();
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+char *itoa(int value, char *str, int base);
+char *ltoa(long value, char *str, int base);
+char *utoa(unsigned value, char *str, int base);
+char *ultoa(unsigned long value, char *str, int base);
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size);
+size_t strlcat(char *dst, const char *src, size_t size);
+#endif
+char *strlwr(char *str);
+char *strupr(char *str);
+char *dtostrf(double val, signed char width, unsigned char prec, char *s);
+
+#include "WString.h"
+#include "Print.h"
+#include "Stream.h"
+#include "IPAddress.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
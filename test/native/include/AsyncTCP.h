@@ -0,0 +1,41 @@
+// host-native AsyncTCP: clients never connect
+#pragma once
+#include <Arduino.h>
+
+class AsyncClient;
+typedef std::function<void(void *, AsyncClient *)> AcConnectHandler;
+typedef std::function<void(void *, AsyncClient *, void *data, size_t len)> AcDataHandler;
+typedef std::function<void(void *, AsyncClient *, int8_t error)> AcErrorHandler;
+typedef std::function<void(void *, AsyncClient *, uint32_t time)> AcTimeoutHandler;
+typedef std::function<void(void *, AsyncClient *, size_t len, uint32_t time)> AcAckHandler;
+
+class AsyncClient {
+  public:
+  bool connect(IPAddress, uint16_t) { return false; }
+  bool connect(const char *, uint16_t) { return false; }
+  void close(bool = false) {}
+  void stop() {}
+  bool connected() { return false; }
+  bool connecting() { return false; }
+  bool disconnected() { return true; }
+  bool freeable() { return true; }
+  bool canSend() { return false; }
+  size_t space() { return 0; }
+  size_t add(const char *, size_t, uint8_t = 0) { return 0; }
+  bool send() { return false; }
+  size_t write(const char *) { return 0; }
+  size_t write(const char *, size_t, uint8_t = 0) { return 0; }
+  void setRxTimeout(uint32_t) {}
+  void setAckTimeout(uint32_t) {}
+  void setNoDelay(bool) {}
+  IPAddress remoteIP() { return IPAddress(); }
+  uint16_t remotePort() { return 0; }
+  IPAddress localIP() { return IPAddress(); }
+  void onConnect(AcConnectHandler, void * = nullptr) {}
+  void onDisconnect(AcConnectHandler, void * = nullptr) {}
+  void onData(AcDataHandler, void * = nullptr) {}
+  void onError(AcErrorHandler, void * = nullptr) {}
+  void onTimeout(AcTimeoutHandler, void * = nullptr) {}
+  void onAck(AcAckHandler, void * = nullptr) {}
+  void onPoll(AcConnectHandler, void * = nullptr) {}
+};
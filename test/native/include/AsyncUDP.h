@@ -0,0 +1,39 @@
+// host-native AsyncUDP: never receives, discards sends
+#pragma once
+#include <Arduino.h>
+#include <lwip/ip_addr.h>
+
+class AsyncUDPPacket : public Stream {
+  public:
+  uint8_t *data() { return nullptr; }
+  size_t length() { return 0; }
+  bool isBroadcast() { return false; }
+  bool isMulticast() { return false; }
+  IPAddress remoteIP() { return IPAddress(); }
+  uint16_t remotePort() { return 0; }
+  IPAddress localIP() { return IPAddress(); }
+  uint16_t localPort() { return 0; }
+  size_t write(uint8_t) override { return 0; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+
+typedef std::function<void(AsyncUDPPacket &packet)> AuPacketHandlerFunction;
+typedef enum { TCPIP_ADAPTER_IF_STA, TCPIP_ADAPTER_IF_AP, TCPIP_ADAPTER_IF_ETH, TCPIP_ADAPTER_IF_MAX } tcpip_adapter_if_t;
+
+class AsyncUDP : public Print {
+  public:
+  bool listen(uint16_t) { return true; }
+  bool listen(const IPAddress &, uint16_t) { return true; }
+  bool listenMulticast(const IPAddress &, uint16_t, uint8_t = 1, tcpip_adapter_if_t = TCPIP_ADAPTER_IF_MAX) { return true; }
+  void close() {}
+  void onPacket(AuPacketHandlerFunction) {}
+  void onPacket(std::function<void(void *, AsyncUDPPacket &)>, void *) {}
+  size_t writeTo(const uint8_t *, size_t len, const IPAddress &, uint16_t, tcpip_adapter_if_t = TCPIP_ADAPTER_IF_MAX) { return len; }
+  size_t broadcastTo(const uint8_t *, size_t len, uint16_t, tcpip_adapter_if_t = TCPIP_ADAPTER_IF_MAX) { return len; }
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+  bool connected() { return false; }
+};
@@ -0,0 +1,322 @@
+/*
+ * host-native ESPAsyncWebServer (subset of the Aircoookie fork API used by WLED)
+ * There is no network: a test builds an AsyncWebServerRequest by hand, passes it to a handler
+ * and then pulls the body out of the response with hostReadResponse(), which drives the
+ * response the same way the TCP send loop on the device does (bounded buffers, _fillBuffer()).
+ */
+#pragma once
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <FS.h>
+#include <vector>
+#include <memory>
+
+#define SPIFFS_EDITOR_AIRCOOOKIE
+#define ASYNCWEBSERVER_REGEX 0
+
+typedef enum {
+  HTTP_GET     = 0b00000001,
+  HTTP_POST    = 0b00000010,
+  HTTP_DELETE  = 0b00000100,
+  HTTP_PUT     = 0b00001000,
+  HTTP_PATCH   = 0b00010000,
+  HTTP_HEAD    = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY     = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+#define HTTP_PULL (HTTP_GET | HTTP_HEAD)
+
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+static const char CONTENT_TYPE_CSS[] PROGMEM = "text/css";
+static const char CONTENT_TYPE_HTML[] PROGMEM = "text/html";
+static const char CONTENT_TYPE_JAVASCRIPT[] PROGMEM = "application/javascript";
+static const char CONTENT_TYPE_JSON[] PROGMEM = "application/json";
+static const char CONTENT_TYPE_PLAIN[] PROGMEM = "text/plain";
+
+class AsyncWebServerRequest;
+class AsyncWebServerResponse;
+
+typedef std::function<size_t(uint8_t *buffer, size_t maxLen, size_t index)> AwsResponseFiller;
+typedef std::function<String(const String &)> AwsTemplateProcessor;
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, const String &filename, size_t index, uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)> ArBodyHandlerFunction;
+
+// contiguous heap buffer, moved into responses without copying
+class DynamicBuffer {
+  std::vector<char> _data;
+  public:
+  DynamicBuffer() {}
+  explicit DynamicBuffer(size_t len) : _data(len) {}
+  char *data() { return _data.data(); }
+  const char *data() const { return _data.data(); }
+  size_t size() const { return _data.size(); }
+  void resize(size_t len) { _data.resize(len); }
+  void clear() { _data.clear(); }
+  explicit operator bool() const { return !_data.empty(); }
+};
+inline String toString(DynamicBuffer &&buf) { return String(buf.data()); }
+
+class AsyncWebParameter {
+  String _name, _value;
+  bool _isForm, _isFile;
+  public:
+  AsyncWebParameter(const String &name, const String &value, bool form = false, bool file = false) : _name(name), _value(value), _isForm(form), _isFile(file) {}
+  const String &name() const { return _name; }
+  const String &value() const { return _value; }
+  bool isPost() const { return _isForm; }
+  bool isFile() const { return _isFile; }
+};
+
+class AsyncWebHeader {
+  String _name, _value;
+  public:
+  AsyncWebHeader(const String &name, const String &value) : _name(name), _value(value) {}
+  const String &name() const { return _name; }
+  const String &value() const { return _value; }
+};
+
+class AsyncWebServerResponse {
+  protected:
+  int _code = 200;
+  String _contentType;
+  size_t _contentLength = 0;
+  size_t _sentLength = 0;
+  bool _sendContentLength = true;
+  bool _chunked = false;
+  std::vector<AsyncWebHeader> _headers;
+  public:
+  virtual ~AsyncWebServerResponse() {}
+  virtual bool _sourceValid() const { return false; }
+  // host only: produce up to maxLen bytes of body; 0 ends the response
+  virtual size_t _hostFill(uint8_t *, size_t) { return 0; }
+  void setCode(int code) { _code = code; }
+  void setContentLength(size_t len) { _contentLength = len; }
+  void setContentType(const String &type) { _contentType = type; }
+  void addHeader(const String &name, const String &value) { _headers.emplace_back(name, value); }
+  int code() const { return _code; }
+  const String &contentType() const { return _contentType; }
+  size_t contentLength() const { return _contentLength; }
+  bool chunked() const { return _chunked; }
+};
+
+class AsyncBasicResponse : public AsyncWebServerResponse {
+  String _content;
+  public:
+  AsyncBasicResponse(int code, const String &contentType = String(), const String &content = String()) : _content(content) {
+    _code = code; _contentType = contentType; _contentLength = content.length();
+  }
+  bool _sourceValid() const override { return true; }
+  size_t _hostFill(uint8_t *buf, size_t maxLen) override {
+    size_t n = std::min<size_t>(maxLen, _content.length() - _sentLength);
+    memcpy(buf, _content.c_str() + _sentLength, n);
+    _sentLength += n;
+    return n;
+  }
+};
+
+class AsyncAbstractResponse : public AsyncWebServerResponse {
+  public:
+  virtual size_t _fillBuffer(uint8_t *, size_t) { return 0; }
+  size_t _hostFill(uint8_t *buf, size_t maxLen) override {
+    size_t len = maxLen;
+    if (!_chunked && _contentLength) len = std::min<size_t>(len, _contentLength - _sentLength);
+    if (!len) return 0;
+    size_t n = _fillBuffer(buf, len);
+    if (n == RESPONSE_TRY_AGAIN) return RESPONSE_TRY_AGAIN;
+    _sentLength += n;
+    return n;
+  }
+};
+
+class AsyncProgmemResponse : public AsyncAbstractResponse {
+  const uint8_t *_content;
+  public:
+  AsyncProgmemResponse(int code, const String &contentType, const uint8_t *content, size_t len) : _content(content) {
+    _code = code; _contentType = contentType; _contentLength = len;
+  }
+  bool _sourceValid() const override { return true; }
+  size_t _fillBuffer(uint8_t *buf, size_t maxLen) override {
+    size_t n = std::min(maxLen, _contentLength - _sentLength);
+    memcpy(buf, _content + _sentLength, n);
+    return n;
+  }
+};
+
+class AsyncChunkedResponse : public AsyncAbstractResponse {
+  AwsResponseFiller _content;
+  size_t _filledLength = 0;
+  public:
+  AsyncChunkedResponse(const String &contentType, AwsResponseFiller callback) : _content(callback) {
+    _code = 200; _contentType = contentType; _chunked = true; _sendContentLength = false;
+  }
+  bool _sourceValid() const override { return !!_content; }
+  size_t _fillBuffer(uint8_t *buf, size_t maxLen) override {
+    size_t n = _content(buf, maxLen, _filledLength);
+    if (n != RESPONSE_TRY_AGAIN) _filledLength += n;
+    return n;
+  }
+};
+
+class AsyncResponseStream : public AsyncAbstractResponse, public Print {
+  String _content;
+  public:
+  AsyncResponseStream(const String &contentType, size_t bufferSize = 0) { _code = 200; _contentType = contentType; _content.reserve(bufferSize); }
+  bool _sourceValid() const override { return true; }
+  size_t _fillBuffer(uint8_t *buf, size_t maxLen) override {
+    size_t n = std::min<size_t>(maxLen, _content.length() - _sentLength);
+    memcpy(buf, _content.c_str() + _sentLength, n);
+    return n;
+  }
+  size_t write(uint8_t c) override { _content.concat((char)c); _contentLength++; return 1; }
+  size_t write(const uint8_t *data, size_t len) override { _content.concat((const char *)data, len); _contentLength += len; return len; }
+  using Print::write;
+};
+
+class AsyncWebServerRequest {
+  String _url;
+  WebRequestMethodComposite _method;
+  std::vector<AsyncWebParameter> _params;
+  AsyncWebServerResponse *_response = nullptr;
+  bool _deferred = false;
+  public:
+  void *_tempObject = nullptr;
+
+  AsyncWebServerRequest(const String &url = String(F("/")), WebRequestMethodComposite method = HTTP_GET) : _url(url), _method(method) {}
+  ~AsyncWebServerRequest() { delete _response; if (_tempObject) free(_tempObject); }
+
+  const String &url() const { return _url; }
+  WebRequestMethodComposite method() const { return _method; }
+  AsyncClient *client() { static AsyncClient c; return &c; }
+  void addInterestingHeader(const String &) {}
+  bool hasHeader(const String &) const { return false; }
+  AsyncWebHeader *getHeader(const String &) const { return nullptr; }
+  const String &header(const char *) const { static String empty; return empty; }
+
+  void addParam(const String &name, const String &value, bool post = false) { _params.emplace_back(name, value, post); }
+  size_t params() const { return _params.size(); }
+  size_t args() const { return _params.size(); }
+  const String &arg(size_t i) const { static String empty; return i < _params.size() ? _params[i].value() : empty; }
+  const String &argName(size_t i) const { static String empty; return i < _params.size() ? _params[i].name() : empty; }
+  AsyncWebParameter *getParam(size_t i) { return i < _params.size() ? &_params[i] : nullptr; }
+  AsyncWebParameter *getParam(const String &name, bool post = false, bool = false) {
+    for (auto &p : _params) if (p.name() == name && p.isPost() == post) return &p;
+    return nullptr;
+  }
+  bool hasParam(const String &name, bool post = false, bool file = false) { return getParam(name, post, file) != nullptr; }
+  bool hasArg(const String &name) { return getParam(name) || getParam(name, true); }
+  const String &arg(const String &name) { static String empty; auto p = getParam(name); if (!p) p = getParam(name, true); return p ? p->value() : empty; }
+
+  void send(AsyncWebServerResponse *response) { delete _response; _response = response; }
+  void send(int code, const String &contentType = String(), const String &content = String()) { send(beginResponse(code, contentType, content)); }
+  void send_P(int code, const String &contentType, const char *content) { send(new AsyncProgmemResponse(code, contentType, (const uint8_t *)content, strlen(content))); }
+  void send_P(int code, const String &contentType, const uint8_t *content, size_t len) { send(new AsyncProgmemResponse(code, contentType, content, len)); }
+  void send(FS &, const String &, const String & = String(), bool = false) { send(404); }
+  void sendChunked(const String &contentType, AwsResponseFiller callback) { send(beginChunkedResponse(contentType, callback)); }
+  void redirect(const String &url) { auto r = beginResponse(302); r->addHeader(F("Location"), url); send(r); }
+  void deferResponse() { _deferred = true; }
+
+  AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(), const String &content = String()) { return new AsyncBasicResponse(code, contentType, content); }
+  AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content, size_t len) { return new AsyncProgmemResponse(code, contentType, content, len); }
+  AsyncWebServerResponse *beginChunkedResponse(const String &contentType, AwsResponseFiller callback) { return new AsyncChunkedResponse(contentType, callback); }
+  AsyncWebServerResponse *beginResponse(FS &, const String &, const String & = String(), bool = false, AwsTemplateProcessor = nullptr) { return new AsyncBasicResponse(404); }
+  AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460) { return new AsyncResponseStream(contentType, bufferSize); }
+
+  // host only
+  AsyncWebServerResponse *response() const { return _response; }
+  bool deferred() const { return _deferred; }
+};
+
+// host only: read the complete body of the response sent to a request, using fills of at most chunkSize bytes
+String hostReadResponse(AsyncWebServerRequest *request, size_t chunkSize = 1436);
+
+class AsyncWebHandler {
+  public:
+  virtual ~AsyncWebHandler() {}
+  virtual bool canHandle(AsyncWebServerRequest *) { return false; }
+  virtual void handleRequest(AsyncWebServerRequest *) {}
+  virtual void handleUpload(AsyncWebServerRequest *, const String &, size_t, uint8_t *, size_t, bool) {}
+  virtual void handleBody(AsyncWebServerRequest *, uint8_t *, size_t, size_t, size_t) {}
+  virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler {
+  public:
+  AsyncCallbackWebHandler &setFilter(std::function<bool(AsyncWebServerRequest *)>) { return *this; }
+};
+
+struct AsyncWebServerQueueLimits {
+  size_t nParallel;
+  size_t queueLength;
+  size_t minHeap;
+  size_t heapUsage;
+};
+
+class AsyncWebServer {
+  public:
+  AsyncWebServer(uint16_t, const AsyncWebServerQueueLimits & = {0, 0, 0, 0}) {}
+  void begin() {}
+  void end() {}
+  AsyncWebHandler &addHandler(AsyncWebHandler *handler) { _handlers.emplace_back(handler); return *handler; }
+  AsyncCallbackWebHandler &on(const char *, ArRequestHandlerFunction) { return _dummy; }
+  AsyncCallbackWebHandler &on(const char *, WebRequestMethodComposite, ArRequestHandlerFunction) { return _dummy; }
+  AsyncCallbackWebHandler &on(const char *, WebRequestMethodComposite, ArRequestHandlerFunction, ArUploadHandlerFunction) { return _dummy; }
+  AsyncCallbackWebHandler &on(const char *, WebRequestMethodComposite, ArRequestHandlerFunction, ArUploadHandlerFunction, ArBodyHandlerFunction) { return _dummy; }
+  void onNotFound(ArRequestHandlerFunction) {}
+  void onFileUpload(ArUploadHandlerFunction) {}
+  void onRequestBody(ArBodyHandlerFunction) {}
+  void reset() {}
+  private:
+  std::vector<std::unique_ptr<AsyncWebHandler>> _handlers;
+  AsyncCallbackWebHandler _dummy;
+};
+
+// websockets: no clients are ever connected
+typedef enum { WS_EVT_CONNECT, WS_EVT_DISCONNECT, WS_EVT_PONG, WS_EVT_ERROR, WS_EVT_DATA } AwsEventType;
+typedef enum { WS_CONTINUATION, WS_TEXT, WS_BINARY, WS_DISCONNECT = 0x08, WS_PING, WS_PONG } AwsFrameType;
+typedef struct { uint8_t message_opcode; uint32_t num; uint8_t final; uint8_t masked; uint8_t opcode; uint64_t len; uint8_t mask[4]; uint64_t index; } AwsFrameInfo;
+
+class AsyncWebSocketBuffer : public DynamicBuffer {
+  public:
+  AsyncWebSocketBuffer() {}
+  explicit AsyncWebSocketBuffer(size_t len) : DynamicBuffer(len) {}
+};
+
+class AsyncWebSocket;
+class AsyncWebSocketClient {
+  public:
+  uint32_t id() const { return 0; }
+  AsyncClient *client() { static AsyncClient c; return &c; }
+  IPAddress remoteIP() const { return IPAddress(); }
+  size_t queueLength() const { return 0; }
+  bool queueIsFull() const { return false; }
+  bool canSend() const { return false; }
+  void text(const String &) {}
+  void text(const char *, size_t = 0) {}
+  void text(AsyncWebSocketBuffer) {}
+  void binary(const uint8_t *, size_t) {}
+  void binary(AsyncWebSocketBuffer) {}
+  void close(uint16_t = 0, const char * = nullptr) {}
+  void ping(const uint8_t * = nullptr, size_t = 0) {}
+};
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler {
+  public:
+  explicit AsyncWebSocket(const String &) {}
+  size_t count() const { return 0; }
+  AsyncWebSocketClient *client(uint32_t) { return nullptr; }
+  bool hasClient(uint32_t) { return false; }
+  void onEvent(AwsEventHandler) {}
+  void cleanupClients(uint16_t = 4) {}
+  void closeAll(uint16_t = 0, const char * = nullptr) {}
+  void textAll(const String &) {}
+  void textAll(const char *, size_t = 0) {}
+  void textAll(AsyncWebSocketBuffer) {}
+  void binaryAll(const uint8_t *, size_t) {}
+  void binaryAll(AsyncWebSocketBuffer) {}
+  bool availableForWriteAll() { return true; }
+  std::vector<AsyncWebSocketClient *> getClients() { return {}; }
+};
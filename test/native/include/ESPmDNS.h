@@ -0,0 +1,15 @@
+#pragma once
+#include <Arduino.h>
+class MDNSResponder {
+  public:
+  bool begin(const char *) { return true; }
+  void end() {}
+  bool addService(const char *, const char *, uint16_t) { return true; }
+  bool addServiceTxt(const char *, const char *, const char *, const char *) { return true; }
+  int queryService(const char *, const char *) { return 0; }
+  IPAddress queryHost(const char *, uint32_t = 2000) { return IPAddress(); }
+  String hostname(int) { return String(); }
+  IPAddress IP(int) { return IPAddress(); }
+  uint16_t port(int) { return 0; }
+};
+extern MDNSResponder MDNS;
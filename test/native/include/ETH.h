@@ -0,0 +1,22 @@
+// host-native Ethernet: no PHY
+#pragma once
+#include <Arduino.h>
+
+typedef enum { ETH_PHY_LAN8720, ETH_PHY_TLK110, ETH_PHY_RTL8201, ETH_PHY_DP83848, ETH_PHY_DM9051, ETH_PHY_KSZ8041, ETH_PHY_KSZ8081, ETH_PHY_MAX } eth_phy_type_t;
+typedef enum { ETH_CLOCK_GPIO0_IN, ETH_CLOCK_GPIO0_OUT, ETH_CLOCK_GPIO16_OUT, ETH_CLOCK_GPIO17_OUT } eth_clock_mode_t;
+
+class ETHClass {
+  public:
+  bool begin(uint8_t = 0, int = -1, int = -1, int = -1, eth_phy_type_t = ETH_PHY_LAN8720, eth_clock_mode_t = ETH_CLOCK_GPIO0_IN) { return false; }
+  bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress(), IPAddress = IPAddress()) { return true; }
+  bool linkUp() { return false; }
+  bool setHostname(const char *) { return true; }
+  IPAddress localIP() { return IPAddress(); }
+  IPAddress subnetMask() { return IPAddress(); }
+  IPAddress gatewayIP() { return IPAddress(); }
+  String macAddress() { return String(F("10:11:12:13:14:15")); }
+  uint8_t *macAddress(uint8_t *mac) { for (int i = 0; i < 6; i++) mac[i] = 0x10 + i; return mac; }
+  uint8_t linkSpeed() { return 0; }
+};
+
+extern ETHClass ETH;
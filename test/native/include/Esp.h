@@ -0,0 +1,31 @@
+// host-native EspClass: reports a plausible ESP32 with effectively unlimited heap
+#pragma once
+#include <stdint.h>
+#include "WString.h"
+
+class EspClass {
+  public:
+  uint32_t getHeapSize() { return 320 * 1024; }
+  uint32_t getFreeHeap() { return 256 * 1024; }
+  uint32_t getMinFreeHeap() { return 200 * 1024; }
+  uint32_t getMaxAllocHeap() { return 128 * 1024; }
+  uint32_t getPsramSize() { return 0; }
+  uint32_t getFreePsram() { return 0; }
+  uint32_t getMaxAllocPsram() { return 0; }
+  uint8_t getChipRevision() { return 3; }
+  const char *getChipModel() { return "host"; }
+  uint8_t getChipCores() { return 2; }
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getCycleCount();
+  const char *getSdkVersion() { return "host"; }
+  uint32_t getFlashChipSize() { return 4 * 1024 * 1024; }
+  uint32_t getFlashChipSpeed() { return 80000000; }
+  uint32_t getSketchSize() { return 0; }
+  uint32_t getFreeSketchSpace() { return 0; }
+  String getSketchMD5() { return String(); }
+  uint64_t getEfuseMac() { return 0x0000AABBCCDDEEFFULL; }
+  void restart();
+  void deepSleep(uint64_t) { restart(); }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,70 @@
+// host-native file system: paths are mapped into a directory on the host (WLED_NATIVE_FS, default ./native_fs)
+#pragma once
+#include <stdio.h>
+#include <memory>
+#include <Arduino.h>
+
+namespace fs {
+
+enum SeekMode { SeekSet = 0, SeekCur = 1, SeekEnd = 2 };
+
+class File : public Stream {
+  public:
+  File() {}
+  File(FILE *f, const char *path, bool dir = false) : _f(f, [](FILE *p){ if (p) fclose(p); }), _path(path), _dir(dir) {}
+  size_t write(uint8_t c) override { return _f ? fwrite(&c, 1, 1, _f.get()) : 0; }
+  size_t write(const uint8_t *buf, size_t size) override { return _f ? fwrite(buf, 1, size, _f.get()) : 0; }
+  using Print::write;
+  int available() override { return _f ? int(size() - position()) : 0; }
+  int read() override { if (!_f) return -1; int c = fgetc(_f.get()); return c == EOF ? -1 : c; }
+  int peek() override { if (!_f) return -1; int c = fgetc(_f.get()); if (c != EOF) ungetc(c, _f.get()); return c == EOF ? -1 : c; }
+  size_t read(uint8_t *buf, size_t size) { return _f ? fread(buf, 1, size, _f.get()) : 0; }
+  size_t readBytes(char *buf, size_t length) override { return read((uint8_t *)buf, length); }
+  void flush() override { if (_f) fflush(_f.get()); }
+  bool seek(uint32_t pos, SeekMode mode = SeekSet) { return _f && fseek(_f.get(), pos, mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END) == 0; }
+  size_t position() const { return _f ? ftell(_f.get()) : 0; }
+  size_t size() const {
+    if (!_f) return 0;
+    long pos = ftell(_f.get()); fseek(_f.get(), 0, SEEK_END);
+    long len = ftell(_f.get()); fseek(_f.get(), pos, SEEK_SET);
+    return len;
+  }
+  void close() { _f.reset(); }
+  operator bool() const { return (bool)_f || _dir; }
+  const char *name() const { const char *n = strrchr(_path.c_str(), '/'); return n ? n + 1 : _path.c_str(); }
+  const char *path() const { return _path.c_str(); }
+  bool isDirectory() const { return _dir; }
+  File openNextFile(const char * = "r") { return File(); }
+  time_t getLastWrite() { return 0; }
+  private:
+  std::shared_ptr<FILE> _f;
+  String _path;
+  bool _dir = false;
+};
+
+class FS {
+  public:
+  bool begin(bool = false, const char * = "/littlefs", uint8_t = 10, const char * = nullptr) { return true; }
+  void end() {}
+  File open(const char *path, const char *mode = "r", bool create = false);
+  File open(const String &path, const char *mode = "r", bool create = false) { return open(path.c_str(), mode, create); }
+  bool exists(const char *path);
+  bool exists(const String &path) { return exists(path.c_str()); }
+  bool remove(const char *path);
+  bool remove(const String &path) { return remove(path.c_str()); }
+  bool rename(const char *from, const char *to);
+  bool rename(const String &from, const String &to) { return rename(from.c_str(), to.c_str()); }
+  bool mkdir(const char *) { return true; }
+  bool rmdir(const char *) { return true; }
+  bool format() { return false; }
+  size_t totalBytes() { return 1024 * 1024; }
+  size_t usedBytes() { return 0; }
+};
+
+} // namespace fs
+
+using fs::FS;
+using fs::File;
+using fs::SeekSet;
+using fs::SeekCur;
+using fs::SeekEnd;
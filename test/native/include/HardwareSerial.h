@@ -0,0 +1,29 @@
+// host-native serial port: output goes to stdout, input is always empty
+#pragma once
+#include <stdio.h>
+#include "Stream.h"
+
+#define SERIAL_8N1 0x800001c
+
+class HardwareSerial : public Stream {
+  public:
+  void begin(unsigned long, uint32_t = SERIAL_8N1, int8_t = -1, int8_t = -1, bool = false, unsigned long = 0) {}
+  void end() {}
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  int availableForWrite() override { return 128; }
+  void flush() override { fflush(stdout); }
+  size_t write(uint8_t c) override { return fputc(c, stdout) == EOF ? 0 : 1; }
+  size_t write(const uint8_t *buffer, size_t size) override { return fwrite(buffer, 1, size, stdout); }
+  using Print::write;
+  void updateBaudRate(unsigned long) {}
+  unsigned long baudRate() { return 115200; }
+  void setRxBufferSize(size_t) {}
+  void setTxBufferSize(size_t) {}
+  void setDebugOutput(bool) {}
+  operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
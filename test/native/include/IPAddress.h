@@ -0,0 +1,36 @@
+// host-native IPAddress (IPv4 only)
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include "Print.h"
+
+class IPAddress : public Printable {
+  union { uint8_t bytes[4]; uint32_t dword; } _address;
+  public:
+  IPAddress() { _address.dword = 0; }
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) { _address.bytes[0] = a; _address.bytes[1] = b; _address.bytes[2] = c; _address.bytes[3] = d; }
+  IPAddress(uint32_t address) { _address.dword = address; }
+  IPAddress(const uint8_t *address) { memcpy(_address.bytes, address, 4); }
+  bool fromString(const char *s) {
+    unsigned a, b, c, d;
+    if (sscanf(s, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+    *this = IPAddress(a, b, c, d);
+    return true;
+  }
+  bool fromString(const String &s) { return fromString(s.c_str()); }
+  operator uint32_t() const { return _address.dword; }
+  bool operator==(const IPAddress &a) const { return _address.dword == a._address.dword; }
+  bool operator!=(const IPAddress &a) const { return _address.dword != a._address.dword; }
+  bool operator==(const uint8_t *a) const { return memcmp(a, _address.bytes, 4) == 0; }
+  uint8_t operator[](int i) const { return _address.bytes[i]; }
+  uint8_t &operator[](int i) { return _address.bytes[i]; }
+  IPAddress &operator=(uint32_t address) { _address.dword = address; return *this; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", _address.bytes[0], _address.bytes[1], _address.bytes[2], _address.bytes[3]);
+    return String(buf);
+  }
+  size_t printTo(Print &p) const override { return p.print(toString()); }
+};
+
+extern const IPAddress INADDR_NONE;
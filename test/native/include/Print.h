@@ -0,0 +1,71 @@
+// host-native Print (Arduino API subset)
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "WString.h"
+
+class Printable;
+
+class Print {
+  public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) {
+    size_t n = 0;
+    while (size--) { if (!write(*buffer++)) break; n++; }
+    return n;
+  }
+  size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+  size_t write(const char *buffer, size_t size) { return write((const uint8_t *)buffer, size); }
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    char buf[256];
+    va_list arg;
+    va_start(arg, format);
+    int len = vsnprintf(buf, sizeof(buf), format, arg);
+    va_end(arg);
+    if (len < 0) return 0;
+    if ((size_t)len < sizeof(buf)) return write((const uint8_t *)buf, len);
+    char *big = new char[len + 1];
+    va_start(arg, format);
+    vsnprintf(big, len + 1, format, arg);
+    va_end(arg);
+    size_t n = write((const uint8_t *)big, len);
+    delete[] big;
+    return n;
+  }
+
+  size_t print(const __FlashStringHelper *s) { return write(reinterpret_cast<const char *>(s)); }
+  size_t print(const String &s) { return write((const uint8_t *)s.c_str(), s.length()); }
+  size_t print(const char s[]) { return write(s); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(unsigned char v, int base = DEC_BASE) { return print((unsigned long)v, base); }
+  size_t print(int v, int base = DEC_BASE) { return print((long)v, base); }
+  size_t print(unsigned v, int base = DEC_BASE) { return print((unsigned long)v, base); }
+  size_t print(long v, int base = DEC_BASE) { return print(String(v, (unsigned char)base)); }
+  size_t print(unsigned long v, int base = DEC_BASE) { return print(String(v, (unsigned char)base)); }
+  size_t print(long long v, int base = DEC_BASE) { return print(String(v, (unsigned char)base)); }
+  size_t print(unsigned long long v, int base = DEC_BASE) { return print(String(v, (unsigned char)base)); }
+  size_t print(double v, int digits = 2) { return print(String(v, (unsigned char)digits)); }
+  size_t print(const Printable &p);
+
+  template<typename T> size_t println(const T &v) { size_t n = print(v); return n + println(); }
+  template<typename T> size_t println(const T &v, int f) { size_t n = print(v, f); return n + println(); }
+  size_t println() { return write("\r\n"); }
+
+  private:
+  static constexpr int DEC_BASE = 10;
+};
+
+class Printable {
+  public:
+  virtual ~Printable() {}
+  virtual size_t printTo(Print &p) const = 0;
+};
+
+inline size_t Print::print(const Printable &p) { return p.printTo(*this); }
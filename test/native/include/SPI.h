@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+#define SPI_MODE0 0
+#define HSPI 2
+#define VSPI 3
+class SPISettings { public: SPISettings(uint32_t = 0, uint8_t = 0, uint8_t = 0) {} };
+class SPIClass {
+  public:
+  SPIClass(uint8_t = 0) {}
+  void begin(int8_t = -1, int8_t = -1, int8_t = -1, int8_t = -1) {}
+  void end() {}
+  void beginTransaction(SPISettings) {}
+  void endTransaction() {}
+  uint8_t transfer(uint8_t) { return 0; }
+  void transfer(void *, uint32_t) {}
+  void writeBytes(const uint8_t *, uint32_t) {}
+};
+extern SPIClass SPI;
@@ -0,0 +1,6 @@
+#pragma once
+#include <ESPAsyncWebServer.h>
+class SPIFFSEditor : public AsyncWebHandler {
+  public:
+  SPIFFSEditor(const String & = String(), const String & = String(), const fs::FS & = fs::FS()) {}
+};
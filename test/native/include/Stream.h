@@ -0,0 +1,36 @@
+// host-native Stream (Arduino API subset)
+#pragma once
+#include "Print.h"
+
+class Stream : public Print {
+  public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+  virtual size_t readBytes(char *buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) { int c = read(); if (c < 0) break; buffer[n++] = (char)c; }
+    return n;
+  }
+  size_t readBytes(uint8_t *buffer, size_t length) { return readBytes((char *)buffer, length); }
+  size_t readBytesUntil(char terminator, char *buffer, size_t length) {
+    size_t n = 0;
+    while (n < length) { int c = read(); if (c < 0 || c == terminator) break; buffer[n++] = (char)c; }
+    return n;
+  }
+  size_t readBytesUntil(char terminator, uint8_t *buffer, size_t length) { return readBytesUntil(terminator, (char *)buffer, length); }
+  bool find(const char *target) {
+    size_t len = strlen(target), idx = 0;
+    if (!len) return true;
+    int c;
+    while ((c = read()) >= 0) {
+      if (c == target[idx]) { if (++idx == len) return true; }
+      else idx = (c == target[0]) ? 1 : 0;
+    }
+    return false;
+  }
+  bool find(char target) { char t[2] = {target, 0}; return find(t); }
+  String readString() { String s; int c; while ((c = read()) >= 0) s += (char)c; return s; }
+  String readStringUntil(char t) { String s; int c; while ((c = read()) >= 0 && c != t) s += (char)c; return s; }
+  void setTimeout(unsigned long) {}
+};
@@ -0,0 +1,13 @@
+// host-native StreamString: String that can be printed to and read from
+#pragma once
+#include "Stream.h"
+
+class StreamString : public Stream, public String {
+  public:
+  size_t write(const uint8_t *data, size_t size) override { concat((const char *)data, size); return size; }
+  size_t write(uint8_t data) override { concat((char)data); return 1; }
+  int available() override { return length(); }
+  int read() override { if (!length()) return -1; char c = charAt(0); remove(0, 1); return (uint8_t)c; }
+  int peek() override { return length() ? (uint8_t)charAt(0) : -1; }
+  void flush() override {}
+};
@@ -0,0 +1,17 @@
+#pragma once
+#include <Arduino.h>
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+class UpdateClass {
+  public:
+  bool begin(size_t = UPDATE_SIZE_UNKNOWN, int = 0) { return false; }
+  size_t write(uint8_t *, size_t) { return 0; }
+  bool end(bool = false) { return false; }
+  bool hasError() { return true; }
+  bool isRunning() { return false; }
+  bool canRollBack() { return false; }
+  bool rollBack() { return false; }
+  void abort() {}
+  String errorString() { return String(F("not supported")); }
+  void printError(Print &) {}
+};
+extern UpdateClass Update;
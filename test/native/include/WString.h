@@ -0,0 +1,142 @@
+// host-native String (subset of the Arduino API used by WLED, backed by std::string)
+#pragma once
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include "pgmspace.h"
+
+class String {
+  std::string _s;
+  public:
+  String() {}
+  String(const char *s) : _s(s ? s : "") {}
+  String(const char *s, size_t len) : _s(s ? s : "", s ? len : 0) {}
+  String(const __FlashStringHelper *s) : _s(s ? reinterpret_cast<const char *>(s) : "") {}
+  String(const String &s) = default;
+  String(String &&s) = default;
+  String(const std::string &s) : _s(s) {}
+  explicit String(char c) : _s(1, c) {}
+  explicit String(unsigned char v, unsigned char base = 10) { fromUnsigned(v, base); }
+  explicit String(int v, unsigned char base = 10) { fromSigned(v, base); }
+  explicit String(unsigned v, unsigned char base = 10) { fromUnsigned(v, base); }
+  explicit String(long v, unsigned char base = 10) { fromSigned(v, base); }
+  explicit String(unsigned long v, unsigned char base = 10) { fromUnsigned(v, base); }
+  explicit String(long long v, unsigned char base = 10) { fromSigned(v, base); }
+  explicit String(unsigned long long v, unsigned char base = 10) { fromUnsigned(v, base); }
+  explicit String(float v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+  explicit String(double v, unsigned char decimals = 2) { fromDouble(v, decimals); }
+  String &operator=(const String &s) = default;
+  String &operator=(String &&s) = default;
+  String &operator=(const char *s) { _s = s ? s : ""; return *this; }
+  String &operator=(const __FlashStringHelper *s) { _s = s ? reinterpret_cast<const char *>(s) : ""; return *this; }
+
+  unsigned int length() const { return _s.length(); }
+  bool isEmpty() const { return _s.empty(); }
+  const char *c_str() const { return _s.c_str(); }
+  char *begin() { return &_s[0]; }
+  char *end() { return &_s[0] + _s.length(); }
+  bool reserve(unsigned int size) { _s.reserve(size); return true; }
+  void clear() { _s.clear(); }
+
+  bool concat(const String &s) { _s += s._s; return true; }
+  bool concat(const char *s) { if (s) _s += s; return true; }
+  bool concat(const char *s, unsigned len) { if (s) _s.append(s, len); return true; }
+  bool concat(const __FlashStringHelper *s) { return concat(reinterpret_cast<const char *>(s)); }
+  bool concat(char c) { _s += c; return true; }
+  bool concat(unsigned char v) { return concat(String(v)); }
+  bool concat(int v) { return concat(String(v)); }
+  bool concat(unsigned v) { return concat(String(v)); }
+  bool concat(long v) { return concat(String(v)); }
+  bool concat(unsigned long v) { return concat(String(v)); }
+  bool concat(long long v) { return concat(String(v)); }
+  bool concat(unsigned long long v) { return concat(String(v)); }
+  bool concat(float v) { return concat(String(v)); }
+  bool concat(double v) { return concat(String(v)); }
+  template<typename T> String &operator+=(const T &v) { concat(v); return *this; }
+
+  char charAt(unsigned int i) const { return i < _s.length() ? _s[i] : 0; }
+  void setCharAt(unsigned int i, char c) { if (i < _s.length()) _s[i] = c; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  char &operator[](unsigned int i) { return _s[i]; }
+
+  int compareTo(const String &s) const { return _s.compare(s._s); }
+  bool equals(const String &s) const { return _s == s._s; }
+  bool equals(const char *s) const { return _s == (s ? s : ""); }
+  bool equalsIgnoreCase(const String &s) const { return strcasecmp(_s.c_str(), s.c_str()) == 0; }
+  bool operator==(const String &s) const { return equals(s); }
+  bool operator==(const char *s) const { return equals(s); }
+  bool operator!=(const String &s) const { return !equals(s); }
+  bool operator!=(const char *s) const { return !equals(s); }
+  bool operator<(const String &s) const { return _s < s._s; }
+  bool startsWith(const String &s) const { return _s.compare(0, s.length(), s._s) == 0; }
+  bool startsWith(const String &s, unsigned int offset) const { return offset <= _s.length() && _s.compare(offset, s.length(), s._s) == 0; }
+  bool endsWith(const String &s) const { return _s.length() >= s.length() && _s.compare(_s.length() - s.length(), s.length(), s._s) == 0; }
+
+  int indexOf(char c, unsigned int from = 0) const { size_t p = _s.find(c, from); return p == std::string::npos ? -1 : (int)p; }
+  int indexOf(const String &s, unsigned int from = 0) const { size_t p = _s.find(s._s, from); return p == std::string::npos ? -1 : (int)p; }
+  int indexOf(const char *s, unsigned int from = 0) const { return indexOf(String(s), from); }
+  int indexOf(const __FlashStringHelper *s, unsigned int from = 0) const { return indexOf(String(s), from); }
+  int lastIndexOf(char c) const { size_t p = _s.rfind(c); return p == std::string::npos ? -1 : (int)p; }
+  int lastIndexOf(const String &s) const { size_t p = _s.rfind(s._s); return p == std::string::npos ? -1 : (int)p; }
+  String substring(unsigned int from) const { return from < _s.length() ? String(_s.substr(from)) : String(); }
+  String substring(unsigned int from, unsigned int to) const {
+    if (from > to) std::swap(from, to);
+    if (from >= _s.length()) return String();
+    return String(_s.substr(from, to - from));
+  }
+  void replace(char f, char r) { for (auto &c : _s) if (c == f) c = r; }
+  void replace(const String &f, const String &r) {
+    if (!f.length()) return;
+    for (size_t p = _s.find(f._s); p != std::string::npos; p = _s.find(f._s, p + r.length())) _s.replace(p, f.length(), r._s);
+  }
+  void remove(unsigned int index) { if (index < _s.length()) _s.erase(index); }
+  void remove(unsigned int index, unsigned int count) { if (index < _s.length()) _s.erase(index, count); }
+  void toLowerCase() { for (auto &c : _s) c = tolower(c); }
+  void toUpperCase() { for (auto &c : _s) c = toupper(c); }
+  void trim() {
+    size_t b = _s.find_first_not_of(" \t\r\n"), e = _s.find_last_not_of(" \t\r\n");
+    _s = (b == std::string::npos) ? std::string() : _s.substr(b, e - b + 1);
+  }
+  long toInt() const { return atol(_s.c_str()); }
+  float toFloat() const { return atof(_s.c_str()); }
+  double toDouble() const { return atof(_s.c_str()); }
+  void toCharArray(char *buf, unsigned int size, unsigned int index = 0) const { getBytes((unsigned char *)buf, size, index); }
+  void getBytes(unsigned char *buf, unsigned int size, unsigned int index = 0) const {
+    if (!size || !buf) return;
+    size_t n = index < _s.length() ? std::min<size_t>(size - 1, _s.length() - index) : 0;
+    memcpy(buf, _s.c_str() + index, n);
+    buf[n] = 0;
+  }
+
+  friend String operator+(const String &a, const String &b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, const char *b) { String r(a); r.concat(b); return r; }
+  friend String operator+(char a, const String &b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const char *a, const String &b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, char b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, int b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, unsigned b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, long b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, unsigned long b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, float b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, double b) { String r(a); r.concat(b); return r; }
+  friend String operator+(const String &a, const __FlashStringHelper *b) { String r(a); r.concat(b); return r; }
+
+  private:
+  void fromSigned(long long v, unsigned char base) {
+    if (v < 0 && base == 10) { fromUnsigned(-(unsigned long long)v, base); _s.insert(_s.begin(), '-'); }
+    else fromUnsigned((unsigned long long)v, base);
+  }
+  void fromUnsigned(unsigned long long v, unsigned char base) {
+    char buf[66]; int i = 65; buf[i] = 0;
+    if (base < 2) base = 10;
+    do { unsigned d = v % base; buf[--i] = d < 10 ? '0' + d : 'a' + d - 10; v /= base; } while (v);
+    _s = buf + i;
+  }
+  void fromDouble(double v, unsigned char decimals) { char buf[64]; snprintf(buf, sizeof(buf), "%.*f", decimals, v); _s = buf; }
+};
+
+class StringSumHelper : public String {
+  public:
+  using String::String;
+  StringSumHelper(const String &s) : String(s) {}
+};
@@ -0,0 +1,75 @@
+// host-native WiFi: reports a permanently disconnected station
+#pragma once
+#include <Arduino.h>
+#include "lwip/def.h"
+#include "esp_mac.h"
+
+typedef enum { WL_NO_SHIELD = 255, WL_IDLE_STATUS = 0, WL_NO_SSID_AVAIL, WL_SCAN_COMPLETED, WL_CONNECTED,
+               WL_CONNECT_FAILED, WL_CONNECTION_LOST, WL_DISCONNECTED } wl_status_t;
+typedef enum { WIFI_MODE_NULL = 0, WIFI_MODE_STA, WIFI_MODE_AP, WIFI_MODE_APSTA, WIFI_MODE_MAX } wifi_mode_t;
+#define WIFI_OFF   WIFI_MODE_NULL
+#define WIFI_STA   WIFI_MODE_STA
+#define WIFI_AP    WIFI_MODE_AP
+#define WIFI_AP_STA WIFI_MODE_APSTA
+typedef enum { WIFI_AUTH_OPEN = 0, WIFI_AUTH_WEP, WIFI_AUTH_WPA_PSK, WIFI_AUTH_WPA2_PSK, WIFI_AUTH_WPA_WPA2_PSK,
+               WIFI_AUTH_WPA2_ENTERPRISE, WIFI_AUTH_WPA3_PSK, WIFI_AUTH_MAX } wifi_auth_mode_t;
+typedef enum { WIFI_PS_NONE, WIFI_PS_MIN_MODEM, WIFI_PS_MAX_MODEM } wifi_ps_type_t;
+typedef enum { WIFI_POWER_19_5dBm = 78, WIFI_POWER_19dBm = 76, WIFI_POWER_18_5dBm = 74, WIFI_POWER_17dBm = 68, WIFI_POWER_15dBm = 60,
+               WIFI_POWER_13dBm = 52, WIFI_POWER_11dBm = 44, WIFI_POWER_8_5dBm = 34, WIFI_POWER_7dBm = 28, WIFI_POWER_5dBm = 20,
+               WIFI_POWER_2dBm = 8, WIFI_POWER_MINUS_1dBm = -4 } wifi_power_t;
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED  (-2)
+typedef int WiFiEvent_t;
+typedef int arduino_event_id_t;
+typedef struct { int dummy; } arduino_event_info_t;
+typedef struct { int event_id; arduino_event_info_t event_info; } arduino_event_t;
+
+class WiFiClass {
+  public:
+  wl_status_t status() { return WL_DISCONNECTED; }
+  bool isConnected() { return false; }
+  IPAddress localIP() { return IPAddress(); }
+  IPAddress subnetMask() { return IPAddress(); }
+  IPAddress gatewayIP() { return IPAddress(); }
+  IPAddress dnsIP(uint8_t = 0) { return IPAddress(); }
+  IPAddress broadcastIP() { return IPAddress(255, 255, 255, 255); }
+  IPAddress softAPIP() { return IPAddress(4, 3, 2, 1); }
+  IPAddress softAPBroadcastIP() { return IPAddress(4, 3, 2, 255); }
+  uint8_t softAPgetStationNum() { return 0; }
+  String macAddress() { return String(F("10:11:12:13:14:15")); }
+  uint8_t *macAddress(uint8_t *mac) { for (int i = 0; i < 6; i++) mac[i] = 0x10 + i; return mac; }
+  String softAPmacAddress() { return macAddress(); }
+  String SSID() { return String(); }
+  String SSID(uint8_t) { return String(); }
+  String BSSIDstr() { return String(); }
+  String BSSIDstr(uint8_t) { return String(); }
+  uint8_t *BSSID(uint8_t = 0) { return nullptr; }
+  int32_t RSSI() { return 0; }
+  int32_t RSSI(uint8_t) { return 0; }
+  int32_t channel() { return 1; }
+  int32_t channel(uint8_t) { return 1; }
+  wifi_auth_mode_t encryptionType(uint8_t) { return WIFI_AUTH_OPEN; }
+  int16_t scanNetworks(bool = false, bool = false, bool = false, uint32_t = 300, uint8_t = 0) { return 0; }
+  int16_t scanComplete() { return 0; }
+  void scanDelete() {}
+  wifi_mode_t getMode() { return WIFI_MODE_NULL; }
+  bool mode(wifi_mode_t) { return true; }
+  bool disconnect(bool = false, bool = false) { return true; }
+  bool softAPdisconnect(bool = false) { return true; }
+  bool setSleep(bool) { return true; }
+  bool setSleep(wifi_ps_type_t) { return true; }
+  bool setTxPower(wifi_power_t) { return true; }
+  wifi_power_t getTxPower() { return WIFI_POWER_19_5dBm; }
+  bool setHostname(const char *) { return true; }
+  const char *getHostname() { return "wled"; }
+  bool setAutoReconnect(bool) { return true; }
+  bool persistent(bool) { return true; }
+  bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress(), IPAddress = IPAddress()) { return true; }
+  bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+  bool softAP(const char *, const char * = nullptr, int = 1, int = 0, int = 4) { return true; }
+  wl_status_t begin(const char *, const char * = nullptr, int32_t = 0, const uint8_t * = nullptr, bool = true) { return WL_DISCONNECTED; }
+  void onEvent(std::function<void(arduino_event_id_t, arduino_event_info_t)>) {}
+  int hostByName(const char *, IPAddress &) { return 0; }
+};
+
+extern WiFiClass WiFi;
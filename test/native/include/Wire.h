@@ -0,0 +1,18 @@
+#pragma once
+#include <Arduino.h>
+class TwoWire : public Stream {
+  public:
+  bool begin(int = -1, int = -1, uint32_t = 0) { return false; }
+  bool end() { return true; }
+  bool setPins(int, int) { return true; }
+  void setClock(uint32_t) {}
+  void beginTransmission(uint16_t) {}
+  uint8_t endTransmission(bool = true) { return 2; }
+  uint8_t requestFrom(uint16_t, uint8_t, bool = true) { return 0; }
+  size_t write(uint8_t) override { return 1; }
+  using Print::write;
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+};
+extern TwoWire Wire;
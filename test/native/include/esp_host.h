@@ -0,0 +1,130 @@
+// host-native shims for the ESP-IDF / FreeRTOS APIs referenced by WLED core code
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+typedef int esp_err_t;
+#define ESP_OK   0
+#define ESP_FAIL -1
+#define ESP_ERR_NO_MEM 0x101
+#define ESP_ERR_INVALID_ARG 0x102
+#define ESP_ERR_INVALID_STATE 0x103
+#define ESP_ERR_NOT_FOUND 0x105
+#define ESP_ERR_TIMEOUT 0x107
+
+// heap_caps: host has a single heap, PSRAM is reported as absent
+#define MALLOC_CAP_EXEC      (1<<0)
+#define MALLOC_CAP_32BIT     (1<<1)
+#define MALLOC_CAP_8BIT      (1<<2)
+#define MALLOC_CAP_DMA       (1<<3)
+#define MALLOC_CAP_SPIRAM    (1<<10)
+#define MALLOC_CAP_INTERNAL  (1<<11)
+#define MALLOC_CAP_DEFAULT   (1<<12)
+#define MALLOC_CAP_IRAM_8BIT (1<<13)
+#define MALLOC_CAP_RETENTION (1<<14)
+#define MALLOC_CAP_RTCRAM    (1<<15)
+inline void *heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void *heap_caps_calloc(size_t n, size_t size, uint32_t) { return calloc(n, size); }
+inline void *heap_caps_realloc(void *ptr, size_t size, uint32_t) { return realloc(ptr, size); }
+inline void *heap_caps_malloc_prefer(size_t size, size_t, ...) { return malloc(size); }
+inline void *heap_caps_calloc_prefer(size_t n, size_t size, size_t, ...) { return calloc(n, size); }
+inline void *heap_caps_realloc_prefer(void *ptr, size_t size, size_t, ...) { return realloc(ptr, size); }
+inline void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t) { return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment); }
+inline void heap_caps_free(void *ptr) { free(ptr); }
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_total_size(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+#define SOC_DRAM_LOW  0
+#define SOC_DRAM_HIGH UINTPTR_MAX
+inline bool psramFound() { return false; }
+inline bool psramInit() { return false; }
+inline void *ps_malloc(size_t size) { return malloc(size); }
+inline void *ps_calloc(size_t n, size_t size) { return calloc(n, size); }
+inline void *ps_realloc(void *ptr, size_t size) { return realloc(ptr, size); }
+inline bool esp_ptr_external_ram(const void *) { return false; }
+inline bool esp_ptr_in_dram(const void *) { return true; }
+inline bool esp_ptr_internal(const void *) { return true; }
+inline bool esp_ptr_byte_accessible(const void *) { return true; }
+inline bool esp_ptr_dma_capable(const void *) { return true; }
+
+// FreeRTOS: the host build is single threaded, synchronisation primitives always succeed
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void *TaskHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void *QueueHandle_t;
+typedef void (*TaskFunction_t)(void *);
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY 0xFFFFFFFFU
+#define portTICK_PERIOD_MS 1
+#define portTICK_RATE_MS 1
+#define configTICK_RATE_HZ 1000
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define tskNO_AFFINITY 0x7FFFFFFF
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) (void)(mux)
+#define portEXIT_CRITICAL(mux) (void)(mux)
+#define portENTER_CRITICAL_ISR(mux) (void)(mux)
+#define portEXIT_CRITICAL_ISR(mux) (void)(mux)
+#define taskENTER_CRITICAL(mux) (void)(mux)
+#define taskEXIT_CRITICAL(mux) (void)(mux)
+#define portYIELD_FROM_ISR()
+typedef int portMUX_TYPE;
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { static int dummy; return &dummy; }
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int dummy; return &dummy; }
+inline SemaphoreHandle_t xSemaphoreCreateBinary() { static int dummy; return &dummy; }
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t, BaseType_t *) { return pdTRUE; }
+inline void vSemaphoreDelete(SemaphoreHandle_t) {}
+inline TickType_t xTaskGetTickCount() { extern unsigned long millis(); return millis(); }
+inline void vTaskDelay(TickType_t ticks) { extern void delay(uint32_t); delay(ticks); }
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return nullptr; }
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *h, BaseType_t) { if (h) *h = nullptr; return pdFAIL; }
+inline BaseType_t xTaskCreate(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t, TaskHandle_t *h) { if (h) *h = nullptr; return pdFAIL; }
+inline void vTaskDelete(TaskHandle_t) {}
+inline void vTaskSuspend(TaskHandle_t) {}
+inline void vTaskResume(TaskHandle_t) {}
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 4096; }
+inline BaseType_t xPortGetCoreID() { return 1; }
+inline void taskYIELD() {}
+
+inline esp_err_t esp_task_wdt_reset() { return ESP_OK; }
+inline esp_err_t esp_task_wdt_add(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_delete(TaskHandle_t) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_init(uint32_t, bool) { return ESP_OK; }
+inline esp_err_t esp_task_wdt_deinit() { return ESP_OK; }
+
+int64_t esp_timer_get_time();
+typedef enum { ESP_RST_UNKNOWN, ESP_RST_POWERON, ESP_RST_EXT, ESP_RST_SW, ESP_RST_PANIC, ESP_RST_INT_WDT, ESP_RST_TASK_WDT,
+               ESP_RST_WDT, ESP_RST_DEEPSLEEP, ESP_RST_BROWNOUT, ESP_RST_SDIO } esp_reset_reason_t;
+inline esp_reset_reason_t esp_reset_reason() { return ESP_RST_POWERON; }
+inline esp_err_t esp_read_mac(uint8_t *mac, int) { for (int i = 0; i < 6; i++) mac[i] = 0x10 + i; return ESP_OK; }
+inline esp_err_t esp_efuse_mac_get_default(uint8_t *mac) { return esp_read_mac(mac, 0); }
+#define ESP_MAC_WIFI_STA 0
+#define ESP_MAC_ETH 3
+inline uint32_t rtc_get_reset_reason(int) { return 1; }
+
+// rom/rtc.h, esp32/rtc.h
+#define RTCWDT_BROWN_OUT_RESET 15
+inline uint64_t esp_rtc_get_time_us() { return (uint64_t)esp_timer_get_time(); }
+
+// esp_chip_info.h
+typedef enum { CHIP_ESP32 = 1 } esp_chip_model_t;
+typedef struct { esp_chip_model_t model; uint32_t features; uint16_t full_revision; uint8_t cores; uint8_t revision; } esp_chip_info_t;
+inline void esp_chip_info(esp_chip_info_t *info) { info->model = CHIP_ESP32; info->features = 0; info->full_revision = 300; info->cores = 2; info->revision = 3; }
+
+// esp_adc_cal.h
+typedef enum { ADC_UNIT_1 = 1, ADC_UNIT_2 } adc_unit_t;
+typedef enum { ADC_ATTEN_DB_0, ADC_ATTEN_DB_2_5, ADC_ATTEN_DB_6, ADC_ATTEN_DB_11, ADC_ATTEN_DB_12 = ADC_ATTEN_DB_11 } adc_atten_t;
+typedef enum { ADC_WIDTH_BIT_9, ADC_WIDTH_BIT_10, ADC_WIDTH_BIT_11, ADC_WIDTH_BIT_12 } adc_bits_width_t;
+typedef struct { adc_unit_t adc_num; adc_atten_t atten; adc_bits_width_t bit_width; uint32_t coeff_a; uint32_t coeff_b; uint32_t vref; const uint32_t *low_curve; const uint32_t *high_curve; } esp_adc_cal_characteristics_t;
+inline int esp_adc_cal_characterize(adc_unit_t, adc_atten_t, adc_bits_width_t, uint32_t, esp_adc_cal_characteristics_t *ch) { *ch = {}; ch->coeff_a = 53000; ch->coeff_b = 142; return 0; }
@@ -0,0 +1,4 @@
+#pragma once
+#include <WiFi.h>
+inline esp_err_t esp_wifi_set_ps(wifi_ps_type_t) { return ESP_OK; }
+inline esp_err_t esp_wifi_get_mac(int, uint8_t *mac) { return esp_read_mac(mac, 0); }
@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+// byte order helpers (host is little endian like the ESP32); not taken from <arpa/inet.h> as it defines INADDR_NONE
+inline uint16_t lwip_htons(uint16_t x) { return __builtin_bswap16(x); }
+inline uint32_t lwip_htonl(uint32_t x) { return __builtin_bswap32(x); }
+#define htons(x) lwip_htons(x)
+#define ntohs(x) lwip_htons(x)
+#define htonl(x) lwip_htonl(x)
+#define ntohl(x) lwip_htonl(x)
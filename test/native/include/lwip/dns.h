@@ -0,0 +1,5 @@
+#pragma once
+#include "ip_addr.h"
+#include "err.h"
+typedef void (*dns_found_callback)(const char *name, const ip_addr_t *ipaddr, void *callback_arg);
+inline err_t dns_gethostbyname(const char *, ip_addr_t *, dns_found_callback, void *) { return ERR_ARG; }
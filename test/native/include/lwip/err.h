@@ -0,0 +1,6 @@
+#pragma once
+typedef signed char err_t;
+#define ERR_OK 0
+#define ERR_MEM -1
+#define ERR_INPROGRESS -5
+#define ERR_ARG -16
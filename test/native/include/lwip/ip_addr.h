@@ -0,0 +1,6 @@
+#pragma once
+#include <stdint.h>
+#define LWIP_VERSION_MAJOR 2
+typedef struct { uint32_t addr; } ip4_addr_t;
+typedef struct { union { ip4_addr_t ip4; } u_addr; uint8_t type; } ip_addr_t;
+#define IPADDR_TYPE_V4 0
@@ -0,0 +1,10 @@
+// host-native SHA1 (mbedtls API subset)
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+typedef struct { uint32_t total[2]; uint32_t state[5]; unsigned char buffer[64]; } mbedtls_sha1_context;
+void mbedtls_sha1_init(mbedtls_sha1_context *ctx);
+void mbedtls_sha1_free(mbedtls_sha1_context *ctx);
+int mbedtls_sha1_starts_ret(mbedtls_sha1_context *ctx);
+int mbedtls_sha1_update_ret(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen);
+int mbedtls_sha1_finish_ret(mbedtls_sha1_context *ctx, unsigned char output[20]);
@@ -0,0 +1,51 @@
+// host-native replacement of pgmspace.h: flash and RAM share one address space
+#pragma once
+#include <type_traits>
+#include <stdint.h>
+#include <string.h>
+#include <stdio.h>
+
+#define PROGMEM
+#define PGM_P const char *
+#define PGM_VOID_P const void *
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper *>(p))
+#define F(s) FPSTR(s)
+
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+// pointer tables are read with pgm_read_dword() (pointers are 32 bit on the ESP32): read the whole pointer on the host
+template<typename T> inline auto hostReadDword(const T *addr) -> typename std::enable_if<std::is_pointer<T>::value, uintptr_t>::type { return (uintptr_t)*addr; }
+template<typename T> inline auto hostReadDword(const T *addr) -> typename std::enable_if<!std::is_pointer<T>::value, uint32_t>::type { uint32_t v; memcpy(&v, addr, sizeof(v)); return v; }
+inline uint32_t hostReadDword(const void *addr) { uint32_t v; memcpy(&v, addr, sizeof(v)); return v; }
+#define pgm_read_dword(addr) hostReadDword(addr)
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr)   (*(void * const *)(addr))
+#define pgm_read_byte_near(addr)  pgm_read_byte(addr)
+#define pgm_read_word_near(addr)  pgm_read_word(addr)
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define pgm_read_byte_far(addr)   pgm_read_byte(addr)
+#define pgm_read_word_far(addr)   pgm_read_word(addr)
+
+#define memcpy_P    memcpy
+#define memcmp_P    memcmp
+#define strcpy_P    strcpy
+#define strncpy_P   strncpy
+#define strcat_P    strcat
+#define strncat_P   strncat
+#define strcmp_P    strcmp
+#define strncmp_P   strncmp
+#define strcasecmp_P  strcasecmp
+#define strncasecmp_P strncasecmp
+#define strlen_P    strlen
+#define strnlen_P   strnlen
+#define strstr_P    strstr
+#define strchr_P    strchr
+#define strrchr_P   strrchr
+#define sprintf_P   sprintf
+#define snprintf_P  snprintf
+#define vsnprintf_P vsnprintf
+#define printf_P    printf
+#define sscanf_P    sscanf
@@ -0,0 +1,5 @@
+#pragma once
+#include <stdint.h>
+uint32_t esp_random();
+#define WDEV_RND_REG 0
+#define REG_READ(reg) ((void)(reg), esp_random())
@@ -0,0 +1,11 @@
+// host-native WLED glue: strip setup and access to the simulated LED output (see test/native/src/wled_host.cpp)
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+// (re)creates the strip with a single bus of width*height LEDs (2D matrix if height > 1), one segment covering it
+void hostBeginStrip(unsigned width, unsigned height = 1);
+// color of LED i as last sent to the bus by show()
+uint32_t hostGetLed(unsigned i);
+// number of show() calls that reached the bus
+uint32_t hostBusShows();
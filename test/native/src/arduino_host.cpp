@@ -0,0 +1,251 @@
+/*
+ * Host-native implementation of the Arduino/ESP-IDF layer declared in test/native/include
+ * (time, random, string helpers, heap queries, file system, SHA1, global driver objects)
+ */
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <ETH.h>
+#include <ESPmDNS.h>
+#include <Wire.h>
+#include <SPI.h>
+#include <Update.h>
+#include <ESPAsyncWebServer.h>
+#include <mbedtls/sha1.h>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <sys/stat.h>
+
+HardwareSerial Serial;
+HardwareSerial Serial1;
+EspClass ESP;
+WiFiClass WiFi;
+ETHClass ETH;
+MDNSResponder MDNS;
+TwoWire Wire;
+SPIClass SPI;
+UpdateClass Update;
+fs::FS LittleFS;
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+// time: wall clock since start, or simulated (only advanced by delay()/hostAdvanceTime())
+static const auto hostStart = std::chrono::steady_clock::now();
+static bool     hostSimulated = false;
+static uint64_t hostSimulatedUs = 0;
+
+static uint64_t hostMicros()
+{
+  if (hostSimulated) return hostSimulatedUs;
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+
+void hostSetSimulatedTime(bool enable)
+{
+  if (enable && !hostSimulated) hostSimulatedUs = hostMicros();
+  hostSimulated = enable;
+}
+
+void hostAdvanceTime(uint32_t us) { hostSimulatedUs += us; }
+
+unsigned long millis() { return hostMicros() / 1000; }
+unsigned long micros() { return hostMicros(); }
+int64_t esp_timer_get_time() { return hostMicros(); }
+uint32_t EspClass::getCycleCount() { return hostMicros() * 240; }
+void EspClass::restart() { exit(0); }
+
+void delay(uint32_t ms)
+{
+  if (hostSimulated) hostAdvanceTime(ms * 1000);
+  else std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us)
+{
+  if (hostSimulated) hostAdvanceTime(us);
+  else std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {}
+
+// random: fixed seed so runs are repeatable
+static std::mt19937 hostRandom(0x5EED);
+
+uint32_t esp_random() { return hostRandom(); }
+void randomSeed(unsigned long seed) { if (seed) hostRandom.seed(seed); }
+long random(long max) { return max > 0 ? long(hostRandom() % (unsigned long)max) : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  if (in_max == in_min) return out_min;
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+// string helpers from the Arduino core
+static char *hostUltoa(unsigned long value, char *str, int base, bool negative)
+{
+  char buf[8 * sizeof(long) + 2];
+  char *p = buf + sizeof(buf) - 1;
+  *p = 0;
+  if (base < 2 || base > 36) base = 10;
+  do {
+    unsigned d = value % base;
+    *--p = d < 10 ? '0' + d : 'a' + d - 10;
+    value /= base;
+  } while (value);
+  if (negative) *--p = '-';
+  strcpy(str, p);
+  return str;
+}
+
+char *ultoa(unsigned long value, char *str, int base) { return hostUltoa(value, str, base, false); }
+char *utoa(unsigned value, char *str, int base) { return hostUltoa(value, str, base, false); }
+char *ltoa(long value, char *str, int base)
+{
+  if (base == 10 && value < 0) return hostUltoa(-(unsigned long)value, str, base, true);
+  return hostUltoa((unsigned long)value, str, base, false);
+}
+char *itoa(int value, char *str, int base) { return base == 10 ? ltoa(value, str, base) : utoa((unsigned)value, str, base); }
+
+char *dtostrf(double val, signed char width, unsigned char prec, char *s)
+{
+  sprintf(s, "%*.*f", width, prec, val);
+  return s;
+}
+
+char *strlwr(char *str) { for (char *p = str; *p; p++) *p = tolower(*p); return str; }
+char *strupr(char *str) { for (char *p = str; *p; p++) *p = toupper(*p); return str; }
+
+#if !defined(__GLIBC__) || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38)
+size_t strlcpy(char *dst, const char *src, size_t size)
+{
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = 0;
+  }
+  return len;
+}
+
+size_t strlcat(char *dst, const char *src, size_t size)
+{
+  size_t len = strnlen(dst, size);
+  if (len == size) return len + strlen(src);
+  return len + strlcpy(dst + len, src, size - len);
+}
+#endif
+
+// heap: the host has plenty, report the same figures as a typical ESP32 without PSRAM
+size_t heap_caps_get_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : ESP.getFreeHeap(); }
+size_t heap_caps_get_largest_free_block(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : ESP.getMaxAllocHeap(); }
+size_t heap_caps_get_total_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : ESP.getHeapSize(); }
+size_t heap_caps_get_minimum_free_size(uint32_t caps) { return (caps & MALLOC_CAP_SPIRAM) ? 0 : ESP.getMinFreeHeap(); }
+
+// file system: "/cfg.json" is stored as $WLED_NATIVE_FS/cfg.json (default ./native_fs)
+static String hostPath(const char *path)
+{
+  const char *root = getenv("WLED_NATIVE_FS");
+  String p(root && *root ? root : "native_fs");
+  mkdir(p.c_str(), 0755);
+  if (path[0] != '/') p += '/';
+  p += path;
+  return p;
+}
+
+namespace fs {
+
+File FS::open(const char *path, const char *mode, bool create)
+{
+  String p = hostPath(path);
+  struct stat st;
+  if (stat(p.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) return File(nullptr, path, true);
+  char m[4] = {mode[0], mode[1] == '+' ? '+' : 'b', mode[1] == '+' ? 'b' : 0, 0};
+  FILE *f = fopen(p.c_str(), m);
+  return f ? File(f, path) : File();
+}
+
+bool FS::exists(const char *path)
+{
+  struct stat st;
+  return stat(hostPath(path).c_str(), &st) == 0;
+}
+
+bool FS::remove(const char *path) { return ::remove(hostPath(path).c_str()) == 0; }
+bool FS::rename(const char *from, const char *to) { return ::rename(hostPath(from).c_str(), hostPath(to).c_str()) == 0; }
+
+} // namespace fs
+
+// SHA1 (FIPS 180-1)
+static inline uint32_t rol32(uint32_t x, unsigned n) { return (x << n) | (x >> (32 - n)); }
+
+static void sha1Block(mbedtls_sha1_context *ctx, const unsigned char *data)
+{
+  uint32_t w[80];
+  for (int i = 0; i < 16; i++) w[i] = uint32_t(data[4*i]) << 24 | uint32_t(data[4*i+1]) << 16 | uint32_t(data[4*i+2]) << 8 | data[4*i+3];
+  for (int i = 16; i < 80; i++) w[i] = rol32(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
+  uint32_t a = ctx->state[0], b = ctx->state[1], c = ctx->state[2], d = ctx->state[3], e = ctx->state[4];
+  for (int i = 0; i < 80; i++) {
+    uint32_t f, k;
+    if      (i < 20) { f = (b & c) | (~b & d);          k = 0x5A827999; }
+    else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+    else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+    else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+    uint32_t t = rol32(a, 5) + f + e + k + w[i];
+    e = d; d = c; c = rol32(b, 30); b = a; a = t;
+  }
+  ctx->state[0] += a; ctx->state[1] += b; ctx->state[2] += c; ctx->state[3] += d; ctx->state[4] += e;
+}
+
+void mbedtls_sha1_init(mbedtls_sha1_context *ctx) { memset(ctx, 0, sizeof(*ctx)); }
+void mbedtls_sha1_free(mbedtls_sha1_context *ctx) { memset(ctx, 0, sizeof(*ctx)); }
+
+int mbedtls_sha1_starts_ret(mbedtls_sha1_context *ctx)
+{
+  static const uint32_t init[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  ctx->total[0] = ctx->total[1] = 0;
+  memcpy(ctx->state, init, sizeof(init));
+  return 0;
+}
+
+int mbedtls_sha1_update_ret(mbedtls_sha1_context *ctx, const unsigned char *input, size_t ilen)
+{
+  while (ilen--) {
+    ctx->buffer[ctx->total[0] % 64] = *input++;
+    if (++ctx->total[0] == 0) ctx->total[1]++;
+    if (ctx->total[0] % 64 == 0) sha1Block(ctx, ctx->buffer);
+  }
+  return 0;
+}
+
+int mbedtls_sha1_finish_ret(mbedtls_sha1_context *ctx, unsigned char output[20])
+{
+  uint64_t bits = (uint64_t(ctx->total[1]) << 32 | ctx->total[0]) * 8;
+  unsigned char pad = 0x80;
+  mbedtls_sha1_update_ret(ctx, &pad, 1);
+  pad = 0;
+  while (ctx->total[0] % 64 != 56) mbedtls_sha1_update_ret(ctx, &pad, 1);
+  unsigned char len[8];
+  for (int i = 0; i < 8; i++) len[i] = bits >> (56 - 8*i);
+  mbedtls_sha1_update_ret(ctx, len, 8);
+  for (int i = 0; i < 20; i++) output[i] = ctx->state[i/4] >> (24 - 8*(i%4));
+  return 0;
+}
+
+// web server: drain the response like AsyncWebServer would (repeated fills of at most chunkSize bytes)
+String hostReadResponse(AsyncWebServerRequest *request, size_t chunkSize)
+{
+  String body;
+  AsyncWebServerResponse *response = request->response();
+  if (!response || !response->_sourceValid()) return body;
+  uint8_t *buf = new uint8_t[chunkSize];
+  for (unsigned tries = 0; tries < 1000; ) {
+    size_t n = response->_hostFill(buf, chunkSize);
+    if (n == RESPONSE_TRY_AGAIN) { tries++; continue; }
+    if (n == 0) break;
+    body.concat((const char *)buf, n);
+  }
+  delete[] buf;
+  return body;
+}
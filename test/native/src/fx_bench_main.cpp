@@ -0,0 +1,41 @@
+/*
+ * Host-native effect benchmark runner (pio run -e native, see tools/fx_bench.py --native)
+ *
+ * usage: program eff                          effect names (as /json/eff)
+ *        program '{"w":64,"h":64,"n":100}'    runs the benchmark (same options as {"fxbench":{...}}) on a strip of
+ *                                             w x h LEDs and prints the results (as /json/bench)
+ */
+#ifndef PIO_UNIT_TESTING
+#include "wled.h"
+#include "wled_host.h"
+
+int main(int argc, char **argv)
+{
+  DynamicJsonDocument doc(65536);
+  if (argc > 1 && !strcmp(argv[1], "eff")) {
+    serializeModeNames(doc.to<JsonArray>());
+    serializeJson(doc, Serial);
+    Serial.println();
+    return 0;
+  }
+  if (argc > 1 && deserializeJson(doc, argv[1])) {
+    fprintf(stderr, "invalid benchmark options: %s\n", argv[1]);
+    return 2;
+  }
+  JsonObject bench = doc.as<JsonObject>();
+  unsigned w = bench["w"] | 300;
+  unsigned h = bench["h"] | 1;
+  hostBeginStrip(w, h);
+  startFxBenchmark(bench);
+  while (true) {
+    handleFxBenchmark();
+    doc.clear();
+    JsonObject res = doc.to<JsonObject>();
+    serializeFxBenchmark(res);
+    if (!res[F("busy")]) break;
+  }
+  serializeJson(doc, Serial);
+  Serial.println();
+  return 0;
+}
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Host-native WLED glue
+ * Defines the WLED globals, an in-memory LED bus (replaces bus_manager.cpp, which needs NeoPixelBus) and stand-ins for
+ * the parts of wled.cpp, network.cpp and wled_server.cpp that the engine and JSON API call into.
+ */
+#define WLED_DEFINE_GLOBAL_VARS
+#include "wled.h"
+#include "wled_host.h"
+
+// LED bus keeping the last frame in memory
+class BusHost : public Bus {
+  public:
+  BusHost(const BusConfig &bc) : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed), _leds(bc.count, 0) {
+    _hasRgb   = hasRGB(bc.type);
+    _hasWhite = hasWhite(bc.type);
+    _hasCCT   = hasCCT(bc.type);
+    _valid    = true;
+  }
+  void show() override { _shown = _leds; _shows++; }
+  void setPixelColor(unsigned pix, uint32_t c) override { if (pix < _leds.size()) _leds[pix] = c; }
+  uint32_t getPixelColor(unsigned pix) const override { return pix < _leds.size() ? _leds[pix] : 0; }
+  size_t getBusSize() const override { return sizeof(BusHost) + _leds.size() * 2 * sizeof(uint32_t); }
+  uint32_t shownColor(unsigned pix) const { return pix < _shown.size() ? _shown[pix] : 0; }
+  static uint32_t _shows;
+  private:
+  std::vector<uint32_t> _leds, _shown;
+};
+
+uint32_t BusHost::_shows = 0;
+
+int16_t  Bus::_cct      = -1;
+int8_t   Bus::_cctBlend = 0;
+uint8_t  Bus::_gAWM     = 255;
+uint32_t BusNetwork::_sendTime      = 0;
+uint32_t BusNetwork::_framesSkipped = 0;
+
+void Bus::setPixelColors(unsigned pix, const uint32_t *c, unsigned len, bool gamma) {
+  if (pix >= getLength()) return;
+  if (pix + len > getLength()) len = getLength() - pix;
+  for (unsigned i = 0; i < len; i++) setPixelColor(pix + i, (c[i] && gamma) ? gamma32(c[i]) : c[i]);
+}
+
+size_t BusConfig::memUsage() const { return count * 8; }
+
+bool ColorOrderMap::add(uint16_t start, uint16_t len, uint8_t colorOrder) { _mappings.push_back({start, len, colorOrder}); return true; }
+
+namespace BusManager {
+  std::vector<std::unique_ptr<Bus>> busses;
+  uint16_t _gMilliAmpsUsed = 0;
+  uint16_t _gMilliAmpsMax  = ABL_MILLIAMPS_DEFAULT;
+  bool     _useABL         = false;
+  static ColorOrderMap colorOrderMap;
+
+  void    initializeABL() { _useABL = false; }
+  void    applyABL() {}
+  uint8_t getI(uint8_t, const uint8_t*, uint8_t) { return 0; }
+  void    removeAll() { busses.clear(); }
+  int     add(const BusConfig &bc, bool) { busses.push_back(make_unique<BusHost>(bc)); return busses.size(); }
+  void    on() {}
+  void    off() {}
+
+  void setPixelColor(unsigned pix, uint32_t c) {
+    for (auto &bus : busses) if (bus->containsPixel(pix)) bus->setPixelColor(pix - bus->getStart(), c);
+  }
+
+  void setPixelColors(const uint32_t *c, unsigned len, bool gamma, unsigned, unsigned) {
+    for (auto &bus : busses) {
+      unsigned start = bus->getStart();
+      unsigned stop  = std::min(start + bus->getLength(), len);
+      if (start < stop) bus->setPixelColors(0, c + start, stop - start, gamma);
+    }
+  }
+
+  uint32_t getPixelColor(unsigned pix) {
+    for (auto &bus : busses) if (bus->containsPixel(pix)) return bus->getPixelColor(pix - bus->getStart());
+    return 0;
+  }
+
+  void show() { for (auto &bus : busses) bus->show(); }
+  bool canAllShow(bool) { return true; }
+  void setSegmentCCT(int16_t cct, bool allowWBCorrection) {
+    if (cct > 255) cct = 255;
+    if (cct >= 0) { if (allowWBCorrection) cct = 1900 + (cct << 5); }
+    else cct = -1;
+    Bus::setCCT(cct);
+  }
+  String getLEDTypesJSONString() { return String(F("[]")); }
+  ColorOrderMap& getColorOrderMap() { return colorOrderMap; }
+};
+
+void hostBeginStrip(unsigned width, unsigned height)
+{
+  uint8_t pins[OUTPUT_MAX_PINS] = {2, 255, 255, 255, 255};
+  busConfigs.clear();
+  busConfigs.emplace_back(TYPE_WS2812_RGB, pins, 0, width * height, COL_ORDER_RGB);
+  strip.isMatrix = height > 1;
+  strip.panel.clear();
+  if (strip.isMatrix) for (unsigned x = 0; x < width; x += 128) { // panel width is 8 bit
+    WS2812FX::Panel p;
+    p.xOffset = x;
+    p.width   = std::min(width - x, 128U);
+    p.height  = height;
+    strip.panel.push_back(p);
+  }
+  NeoGammaWLEDMethod::calcGammaTable(gammaCorrectVal); // done by deserializeConfig() on a device
+  strip.finalizeInit();
+  if (strip.isMatrix) strip.setUpMatrix();
+  strip.makeAutoSegments(true);
+  strip.setBrightness(255, true);
+  bri = briT = 255;
+  busConfigs.clear();
+}
+
+uint32_t hostGetLed(unsigned i)
+{
+  for (auto &bus : BusManager::busses) if (bus->containsPixel(i)) return static_cast<BusHost*>(bus.get())->shownColor(i - bus->getStart());
+  return 0;
+}
+
+uint32_t hostBusShows() { return BusHost::_shows; }
+
+// wled.cpp
+static uint16_t rolloverMillis = 0;
+uint16_t getRolloverMillis() { return rolloverMillis; }
+WLED::WLED() {}
+void WLED::initAP(bool) {}
+
+// network.cpp
+int getSignalQuality(int rssi) { return rssi <= -100 ? 0 : rssi >= -50 ? 100 : 2 * (rssi + 100); }
+
+void fillMAC2Str(char *str, const uint8_t *mac) {
+  sprintf_P(str, PSTR("%02x%02x%02x%02x%02x%02x"), MAC2STR(mac));
+  byte nul = 0;
+  for (int i = 0; i < 6; i++) nul |= *mac++;
+  if (!nul) str[0] = '\0';
+}
+
+void fillStr2MAC(uint8_t *mac, const char *str) {
+  for (int i = 0; i < 6; i++) *mac++ = 0;
+  if (!str) return;
+  uint64_t MAC = strtoull(str, nullptr, 16);
+  for (int i = 0; i < 6; i++) { *--mac = MAC & 0xFF; MAC >>= 8; }
+}
+
+// wled_server.cpp
+void serveMessage(AsyncWebServerRequest* request, uint16_t code, const String& headl, const String& subl, byte optionT)
+{
+  request->send(code, FPSTR(CONTENT_TYPE_PLAIN), headl + ' ' + subl);
+}
+
+void serveJsonError(AsyncWebServerRequest* request, uint16_t code, uint16_t error)
+{
+  AsyncJsonResponse *response = new AsyncJsonResponse(64);
+  response->setContentType(CONTENT_TYPE_JSON);
+  response->setCode(code);
+  JsonObject obj = response->getRoot();
+  obj[F("error")] = error;
+  response->setLength();
+  request->send(response);
+}
@@ -0,0 +1,145 @@
+/*
+ * HTTP JSON state/info responses are streamed part by part (see StateStreamer in json.cpp):
+ * output has to be byte identical to serializeJson() of serializeState()/serializeInfo()
+ * pio test -e native -f test_json_stream
+ */
+#include <unity.h>
+#include "wled.h"
+#include "wled_host.h"
+
+static void applyState(const char *json)
+{
+  DynamicJsonDocument doc(8192);
+  TEST_ASSERT_FALSE(deserializeJson(doc, json));
+  deserializeState(doc.as<JsonObject>());
+}
+
+// response as generated before streaming: complete document serialized at once
+static String expected(bool state, bool info)
+{
+  DynamicJsonDocument doc(65536);
+  JsonObject root = doc.to<JsonObject>();
+  if (state && info) {
+    serializeState(root.createNestedObject("state"));
+    serializeInfo(root.createNestedObject("info"));
+  } else if (state) serializeState(root);
+  else serializeInfo(root);
+  TEST_ASSERT_FALSE(doc.overflowed());
+  String out;
+  serializeJson(doc, out);
+  return out;
+}
+
+static String streamed(const char *url, size_t chunkSize)
+{
+  AsyncWebServerRequest request(url);
+  serveJson(&request);
+  TEST_ASSERT_NOT_NULL(request.response());
+  return hostReadResponse(&request, chunkSize);
+}
+
+static void checkAll()
+{
+  static const size_t chunkSizes[] = {1436, 100, 7};
+  for (size_t chunkSize : chunkSizes) {
+    errorFlag = ERR_NONE;
+    TEST_ASSERT_EQUAL_STRING(expected(true, false).c_str(), streamed("/json/state", chunkSize).c_str());
+    TEST_ASSERT_EQUAL_STRING(expected(false, true).c_str(), streamed("/json/info", chunkSize).c_str());
+    TEST_ASSERT_EQUAL_STRING(expected(true, true).c_str(), streamed("/json/si", chunkSize).c_str());
+  }
+}
+
+void setUp()
+{
+  hostSetSimulatedTime(true); // uptime etc. must not change between expected and streamed output
+}
+
+void tearDown() {}
+
+static void test_single_segment()
+{
+  hostBeginStrip(300);
+  checkAll();
+}
+
+static void test_many_segments()
+{
+  hostBeginStrip(300);
+  applyState("{\"transition\":0,\"seg\":["
+    "{\"id\":0,\"start\":0,\"stop\":30,\"fx\":9,\"col\":[[255,0,0],[0,0,255]]},"
+    "{\"id\":1,\"start\":30,\"stop\":60,\"fx\":2,\"pal\":11,\"n\":\"second\"},"
+    "{\"id\":2,\"start\":60,\"stop\":90,\"grp\":2,\"spc\":1,\"rev\":true},"
+    "{\"id\":3,\"start\":90,\"stop\":120,\"on\":false},"
+    "{\"id\":4,\"start\":120,\"stop\":150,\"sel\":true,\"bri\":100},"
+    "{\"id\":5,\"start\":150,\"stop\":180,\"mi\":true},"
+    "{\"id\":6,\"start\":180,\"stop\":210,\"sx\":10,\"ix\":250},"
+    "{\"id\":7,\"start\":210,\"stop\":240,\"fx\":28,\"frz\":true},"
+    "{\"id\":8,\"start\":240,\"stop\":270,\"of\":5},"
+    "{\"id\":9,\"start\":270,\"stop\":300,\"cct\":127}]}");
+  TEST_ASSERT_EQUAL(10, strip.getActiveSegmentsNum());
+  checkAll();
+}
+
+static void test_inactive_segments()
+{
+  hostBeginStrip(300);
+  applyState("{\"transition\":0,\"seg\":[{\"id\":0,\"start\":0,\"stop\":100},{\"id\":1,\"start\":100,\"stop\":200},"
+    "{\"id\":2,\"start\":200,\"stop\":300}]}");
+  applyState("{\"seg\":[{\"id\":0,\"stop\":0},{\"id\":1,\"stop\":0}]}"); // only the last segment stays active
+  checkAll();
+}
+
+static void test_matrix_segments()
+{
+  hostBeginStrip(32, 16);
+  applyState("{\"transition\":0,\"seg\":["
+    "{\"id\":0,\"start\":0,\"stop\":16,\"startY\":0,\"stopY\":8,\"fx\":9},"
+    "{\"id\":1,\"start\":16,\"stop\":32,\"startY\":0,\"stopY\":8,\"m12\":1},"
+    "{\"id\":2,\"start\":0,\"stop\":16,\"startY\":8,\"stopY\":16,\"mY\":true,\"tp\":true},"
+    "{\"id\":3,\"start\":16,\"stop\":32,\"startY\":8,\"stopY\":16,\"n\":\"\\\"quoted\\\"\"}]}");
+  checkAll();
+}
+
+// pooled documents all taken: parts are generated with the global JSON buffer
+static void test_global_buffer()
+{
+  hostBeginStrip(300);
+  applyState("{\"transition\":0,\"seg\":[{\"id\":0,\"start\":0,\"stop\":150},{\"id\":1,\"start\":150,\"stop\":300}]}");
+  std::vector<JsonDocument*> taken;
+  while (JsonDocument *doc = requestJSONDocument()) taken.push_back(doc);
+  checkAll();
+  for (auto doc : taken) releaseJSONDocument(doc);
+}
+
+// nothing is generated while segments are being changed, response is cut short if they changed
+static void test_state_change()
+{
+  hostBeginStrip(300);
+  AsyncWebServerRequest request("/json/state");
+  serveJson(&request);
+  AsyncWebServerResponse *response = request.response();
+  uint8_t buf[16];
+  size_t received = response->_hostFill(buf, sizeof(buf));
+  TEST_ASSERT_EQUAL(sizeof(buf), received);
+  strip.suspend();
+  size_t n;
+  while ((n = response->_hostFill(buf, sizeof(buf))) != RESPONSE_TRY_AGAIN) { // rest of the part already generated
+    TEST_ASSERT_TRUE(n > 0);
+    received += n;
+  }
+  strip.resume();
+  TEST_ASSERT_EQUAL(0, response->_hostFill(buf, sizeof(buf)));
+  TEST_ASSERT_TRUE(received < expected(true, false).length());
+}
+
+int main(int argc, char **argv)
+{
+  UNITY_BEGIN();
+  RUN_TEST(test_single_segment);
+  RUN_TEST(test_many_segments);
+  RUN_TEST(test_inactive_segments);
+  RUN_TEST(test_matrix_segments);
+  RUN_TEST(test_global_buffer);
+  RUN_TEST(test_state_change);
+  return UNITY_END();
+}
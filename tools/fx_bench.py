@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+# Runs the on-device effect benchmark (build with -D WLED_ENABLE_FX_BENCHMARK) for one or more
+# segment geometries and reports render time per effect. Effects whose average frame time exceeds
+# the frame budget (1/target FPS) are flagged. Optionally compares with a previous CSV run.
+#
+# usage: fx_bench.py <ip>|--native <program> [-g 300x1 -g 64x64] [-n 100] [-f 0-10] [--psgrid on|off] [--m12 arc] [--m12tab on|off]
+#                    [-o results.csv] [-b baseline.csv] [--idle 10]
+#
+# --idle N only samples frames blended vs. unchanged frames (blending skipped by damage tracking) for N seconds (no effects
+# are run): set a static scene first (e.g. Solid, or any segment with "fps":255), nearly all frames should be unchanged
+#
+# --native runs the host build instead of a device (pio run -e native, program is .pio/build/native/program);
+# timings are host CPU timings, use them to compare runs and to spot regressions, not as device frame rates
+#
+# e.g. cost of 1D expansion on a 32x32 segment with and without precomputed tables:
+#   fx_bench.py <ip> -g 32x32 --m12 pinwheel --m12tab off -o before.csv
+#   fx_bench.py <ip> -g 32x32 --m12 pinwheel --m12tab on -b before.csv
+
+import argparse
+import csv
+import json
+import subprocess
+import time
+import urllib.request
+
+M12 = {"pixels": 0, "bar": 1, "arc": 2, "corner": 3, "pinwheel": 4}
+
+native = None  # host build (program path), replaces the device JSON API
+
+
+def api(host, path, payload=None):
+    if native:
+        arg = "eff" if path == "eff" else json.dumps(payload["fxbench"])
+        return json.loads(subprocess.run([native, arg], check=True, capture_output=True, text=True).stdout)
+    data = json.dumps(payload).encode() if payload is not None else None
+    req = urllib.request.Request(f"http://{host}/json/{path}", data=data, headers={"Content-Type": "application/json"})
+    with urllib.request.urlopen(req, timeout=10) as r:
+        return json.load(r)
+
+
+def run(host, w, h, frames, fx=None, psgrid=None, m12=None, m12tab=None):
+    bench = {"w": w, "h": h, "n": frames}
+    if fx:
+        bench["fx"] = fx
+    if psgrid:
+        bench["psgrid"] = psgrid == "on"
+    if m12:
+        bench["m12"] = M12[m12]
+    if m12tab:
+        bench["m12tab"] = m12tab == "on"
+    if native:
+        return api(host, "state", {"fxbench": bench})  # runs to completion
+    api(host, "state", {"fxbench": bench})
+    time.sleep(0.5)
+    while True:
+        res = api(host, "bench")
+        if not res.get("busy"):
+            return res
+        time.sleep(1)
+
+
+def main():
+    p = argparse.ArgumentParser(description="WLED effect benchmark")
+    p.add_argument("host", nargs="?")
+    p.add_argument("--native", metavar="PROGRAM", help="run host build (pio run -e native) instead of a device")
+    p.add_argument("-g", "--geometry", action="append", help="WxH, may be repeated (default 300x1)")
+    p.add_argument("-n", "--frames", type=int, default=100)
+    p.add_argument("-f", "--fx", help="effect id range first-last (default all)")
+    p.add_argument("--psgrid", choices=["on", "off"], help="particle system collision detection: grid or binning")
+    p.add_argument("--m12", choices=M12.keys(), help="1D effect expansion on 2D segments (default: effect default)")
+    p.add_argument("--m12tab", choices=["on", "off"], help="use precomputed tables for arc and pinwheel expansion")
+    p.add_argument("-o", "--output", help="write results to CSV")
+    p.add_argument("-b", "--baseline", help="compare with CSV from a previous run")
+    p.add_argument("-t", "--tolerance", type=float, default=0.2, help="allowed slowdown vs baseline (default 20%%)")
+    p.add_argument("--idle", type=int, metavar="SEC", help="only measure unchanged frames (blending skipped) of current scene")
+    args = p.parse_args()
+    global native
+    native = args.native
+    if not native and not args.host:
+        p.error("host or --native is required")
+    if native and args.idle:
+        p.error("--idle needs a device")
+
+    if args.idle:
+        shown0, skipped0 = api(args.host, "bench").get("frames", [0, 0])
+        time.sleep(args.idle)
+        shown1, skipped1 = api(args.host, "bench").get("frames", [0, 0])
+        shown, skipped = shown1 - shown0, skipped1 - skipped0
+        total = max(shown + skipped, 1)
+        print(f"{args.idle}s: {shown} frames blended, {skipped} unchanged frames not blended ({100 * skipped // total}%)")
+        return 0
+
+    names = api(args.host, "eff")
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            for row in csv.DictReader(f):
+                baseline[(row["geometry"], int(row["id"]))] = int(row["avg_us"])
+
+    fx = None
+    if args.fx:
+        first, _, last = args.fx.partition("-")
+        fx = [int(first), int(last or first)]
+
+    rows = []
+    failed = 0
+    for g in args.geometry or ["300x1"]:
+        w, h = (int(v) for v in g.lower().split("x"))
+        res = run(args.host, w, h, args.frames, fx, args.psgrid, args.m12, args.m12tab)
+        budget = 1000000 // max(res["fps"], 1)
+        print(f"\n{g}: {res['n']} frames, budget {budget}us/frame, took {res['time'] / 1000:.1f}s, show() {res.get('show', 0)}us")
+        if "psgrid" in res:
+            print(f"particle collisions: {'grid' if res['psgrid'] else 'binning'}")
+        if "m12" in res:
+            print(f"1D expansion: {args.m12}, tables {'on' if res.get('m12tab') else 'off'}")
+        ingest = res.get("ingest", [0, 0])
+        print(f"realtime ingest (full strip): per-pixel {ingest[0]}us, span {ingest[1]}us")
+        for name, (ref, span, same) in res.get("kernels", {}).items():
+            print(f"kernel {name:<12} per-pixel {ref:>5}us, span {span:>5}us{'' if same else ' OUTPUT DIFFERS'}")
+            if not same:
+                failed += 1
+        print(f"{'id':>4} {'name':<24} {'avg us':>8} {'max us':>8} {'data':>6} {'segdata':>8}")
+        for i, (avg, mx, data, used) in enumerate(res.get("fx", []), res.get("first", 0)):
+            if avg == 0 and mx == 0:
+                continue  # reserved effect
+            name = names[i] if i < len(names) else "?"
+            flag = ""
+            if avg > budget:
+                flag = " OVER BUDGET"
+                failed += 1
+            base = baseline.get((g, i))
+            if base and avg > base * (1 + args.tolerance):
+                flag += f" REGRESSION ({base}us)"
+                failed += 1
+            print(f"{i:>4} {name[:24]:<24} {avg:>8} {mx:>8} {data:>6} {used:>8}{flag}")
+            rows.append({"geometry": g, "id": i, "name": name, "avg_us": avg, "max_us": mx, "data": data, "segdata": used})
+
+    if args.output:
+        with open(args.output, "w", newline="") as f:
+            wr = csv.DictWriter(f, fieldnames=["geometry", "id", "name", "avg_us", "max_us", "data", "segdata"])
+            wr.writeheader()
+            wr.writerows(rows)
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
@@ -17,6 +17,7 @@
 #define WS2812FX_h
 
 #include <vector>
+#include <atomic>
 #include "wled.h"
 #include "colors.h"
 #ifdef WLED_DEBUG
@@ -61,6 +62,7 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #define WLED_FPS         42
 #define FRAMETIME_FIXED  (1000/WLED_FPS)
 #define FRAMETIME        strip.getFrameTime()
+#define FULL_FRAME_INTERVAL 1000                                          // unchanged frames are re-sent at least this often (ms) to keep receivers alive
 #if defined(ARDUINO_ARCH_ESP32)
   #if (SOC_CPU_CORES_NUM < 2)
     #define MIN_FRAME_DELAY  3                                            // S2/C3/C6/C5 are slower than normal esp32, and only have one core
@@ -81,6 +83,9 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
 #endif
 #define FPS_CALC_SHIFT 7 // bit shift for fixed point math
 
+// per-segment frame rate (Segment::fps): 0 = render effect on every strip frame, 1-250 = effect FPS
+#define SEGMENT_FPS_ON_CHANGE 255 // render effect only when segment parameters change (static effects)
+
 // heap memory limit for effects data, pixel buffers try to reserve it if PSRAM is available
 #ifdef ESP8266
   #define MAX_NUM_SEGMENTS  16
@@ -102,6 +107,23 @@ extern byte realtimeMode;           // used in getMappedPixelIndex()
   assuming each segment uses the same amount of data. 256 for ESP8266, 640 for ESP32. */
 #define FAIR_DATA_PER_SEG (MAX_SEGMENT_DATA / MAX_NUM_SEGMENTS)
 
+// expanded (256 entry) palette per segment, see Segment::color_from_palette()
+#ifdef ESP8266
+  #define WLED_DISABLE_PALETTE_CACHE // 1kB per segment is too much for ESP8266
+#endif
+#ifndef WLED_PALETTE_CACHE_ALLOC
+  #define WLED_PALETTE_CACHE_ALLOC (BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR) // use BFRALLOC_PREFER_PSRAM to save DRAM
+#endif
+#define PALETTE_CACHE_MIN_LENGTH 64 // shorter segments do too few lookups to pay for building the cache
+
+// segment arena: segment buffers (incl. transition copies) are taken from one block, see SegmentArena
+// (pixel buffers if it is in PSRAM, effect data otherwise)
+#ifdef ESP8266
+  #define WLED_DISABLE_SEGMENT_ARENA // not enough RAM to reserve a block up front
+#endif
+// #define WLED_SEGMENT_ARENA_SIZE (32*1024) // override arena size (default: derived from MAX_SEGMENT_DATA and LED count)
+#define SEGMENT_ARENA_COMPACT_INTERVAL 5000 // ms between fragmentation checks (arena is compacted only if no segment is in transition)
+
 #define MIN_SHOW_DELAY   (_frametime < 16 ? 8 : 15)
 
 #define NUM_COLORS       3 /* number of colors per segment */
@@ -414,6 +436,36 @@ typedef enum mapping1D2D {
   M12_sPinwheel = 4
 } mapping1D2D_t;
 
+#ifndef WLED_DISABLE_SEGMENT_ARENA
+// first-fit allocator for segment buffers working on a single block (in PSRAM if available) allocated once in finalizeInit()
+// blocks carry a 4 byte header (block size, bit 0 set if used) and can be slid together by compact()
+// as long as the pointer holding them is known, see WS2812FX::relocateArenaBlock()
+class SegmentArena {
+  public:
+    typedef bool (*relocate_cb)(const void *from, void *to); // updates owner of a block, returns false if block must not move
+
+    static bool  begin(size_t size, bool external); // (re)creates arena, fails if blocks are in use
+    static void  end();
+    static void *allocate(size_t size, bool clear = false); // returns nullptr if there is no free block large enough
+    static bool  release(void *ptr);                // returns false if ptr does not belong to arena
+    static size_t compact(relocate_cb relocate);    // moves used blocks to the start of arena, returns number of bytes moved
+    static size_t getLargestFree();                 // largest free block (payload)
+
+    static inline bool owns(const void *ptr)   { return _base && ptr >= _base && ptr < _base + _size; }
+    static inline bool isExternal()            { return _external; }
+    static inline size_t getSize()             { return _size; }
+    static inline size_t getUsed()             { return _used; }   // including block headers
+    static inline unsigned getBlocks()         { return _blocks; } // number of used blocks
+
+  private:
+    static uint8_t *_base;
+    static size_t   _size;
+    static size_t   _used;
+    static unsigned _blocks;
+    static bool     _external; // arena is in PSRAM: holds pixel buffers only (effect data stays in DRAM)
+};
+#endif
+
 class WS2812FX;
 class FontManager;
 
@@ -459,6 +511,7 @@ class Segment {
       bool    check3  : 1;        // checkmark 3
     };
     uint8_t   blendMode;          // segment blending modes: top, bottom, add, subtract, difference, average, multiply, divide, lighten, darken, screen, overlay, hardlight, softlight, dodge, burn, stencil
+    uint8_t   fps;                // effect frame rate: 0 = strip frame rate, 1-250, SEGMENT_FPS_ON_CHANGE (strip still shows at its own rate)
     char     *name;               // segment name
 
     // runtime data
@@ -469,11 +522,29 @@ class Segment {
     byte     *data; // effect data pointer
 
     static uint16_t maxWidth, maxHeight;  // these define matrix width & height (max. segment dimensions)
+  #ifndef WLED_DISABLE_2D
+    static bool     useMappingTables;     // precomputed 1D->2D expansion (Arc, Pinwheel), can be disabled for benchmarking
+  #endif
 
   private:
     uint32_t *pixels;                 // pixel data
     unsigned _dataLen;
+    unsigned long _lastRender;        // last time effect was rendered
+    unsigned long _nextRender;        // next render deadline (if segment has its own frame rate)
+    uint32_t _renderSignature;        // hash of effect parameters at last render (SEGMENT_FPS_ON_CHANGE)
+    uint32_t _renderFps;              // actual effect frame rate (fixed point, see FPS_CALC_SHIFT)
+    uint16_t _renderTime;             // average effect render time (us)
+  #ifndef WLED_DISABLE_2D
+    mutable uint16_t *_mappingTable;  // 1D->2D expansion (pArc, sPinwheel) as pixel index lists, see getMappingTable()
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+    struct PaletteCache {
+      CRGBPalette16 source;           // palette the entries were built from
+      uint32_t      entries[256];     // ColorFromPalette(source, i, 255, LINEARBLEND)
+    } *_paletteCache;
+  #endif
     uint8_t  _default_palette;        // palette number that gets assigned to pal0
+    mutable bool _dirty;              // pixel data changed since segment was last blended into frame buffer
     union {
       mutable uint8_t _capabilities;  // determines segment capabilities in terms of what is available: RGB, W, CCT, manual W, etc.
       struct {
@@ -490,6 +561,10 @@ class Segment {
     static unsigned      _vWidth, _vHeight;   // 2D dimensions used for current effect
     static uint32_t      _currentColors[NUM_COLORS]; // colors used for current effect (faster access from effect functions)
     static CRGBPalette16 _currentPalette;     // palette used for current effect (includes transition, used in color_from_palette())
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+    static PaletteCache *_currentPaletteCache; // expanded _currentPalette of current segment (nullptr if not used)
+    static bool          _paletteCacheValid;  // entries match _currentPalette, otherwise rebuilt on first lookup
+  #endif
     static CRGBPalette16 _randomPalette;      // actual random palette
     static CRGBPalette16 _newRandomPalette;   // target random palette
     static uint16_t      _lastPaletteChange;  // last random palette change time (in seconds)
@@ -531,15 +606,29 @@ class Segment {
 
     inline static void addUsedSegmentData(int len) { Segment::_usedSegmentData = max(0, int(Segment::_usedSegmentData) + len); }  // clamp negative results to 0
 
-    inline uint32_t *getPixels() const                              { return pixels; }
-    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { pixels[i] = c; }
+    inline uint32_t *getPixels() const                              { _dirty = true; return pixels; } // caller may write directly (particle system), assume it does
+    inline const uint32_t *getPixelsRaw() const                     { return pixels; } // read only access (blending), keeps dirty flag
+    inline void     setPixelColorRaw(unsigned i, uint32_t c) const  { _dirty |= (pixels[i] != c); pixels[i] = c; }
     inline uint32_t getPixelColorRaw(unsigned i) const              { return pixels[i]; };
   #ifndef WLED_DISABLE_2D
-    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; pixels[XY(x,y)] = c; }
+    inline void     setPixelColorXYRaw(unsigned x, unsigned y, uint32_t c) const  { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; _dirty |= (pixels[XY(x,y)] != c); pixels[XY(x,y)] = c; }
     inline uint32_t getPixelColorXYRaw(unsigned x, unsigned y) const              { auto XY = [](unsigned X, unsigned Y){ return X + Y*Segment::vWidth(); }; return pixels[XY(x,y)]; };
   #endif
     void resetIfRequired();         // sets all SEGENV variables to 0 and clears data buffer
+    bool isRenderDue(unsigned long t, unsigned frameTime); // effect needs to run in this strip frame (per-segment FPS)
+    void updateRenderStats(unsigned long t, unsigned us);
+  #ifndef WLED_DISABLE_2D
+    const uint16_t *getMappingTable(int vW, int vH) const; // builds table on first use, nullptr if not available
+    void freeMappingTable() const;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+    inline void freePaletteCache() { if (_currentPaletteCache == _paletteCache) _currentPaletteCache = nullptr; p_free(_paletteCache); _paletteCache = nullptr; }
+    static void buildPaletteCache();  // expands _currentPalette into _currentPaletteCache
+  #endif
     void loadPalette(CRGBPalette16 &tgt, uint8_t pal);
+    static void *allocateBuffer(size_t len, uint32_t type); // pixel & effect data buffers: segment arena if possible, heap otherwise
+    static void freeBuffer(void *ptr);
+    Segment *createOldSegment(bool handOver); // segment copy for transition, handOver: old segment takes effect data & pixels
 
     // transition functions
     void stopTransition();                  // ends transition mode by destroying transition structure (does nothing if not in transition)
@@ -582,6 +671,7 @@ class Segment {
     , check2(false)
     , check3(false)
     , blendMode(0)
+    , fps(0)
     , name(nullptr)
     , step(0)
     , call(0)
@@ -589,13 +679,25 @@ class Segment {
     , aux1(0)
     , data(nullptr)
     , _dataLen(0)
+    , _lastRender(0)
+    , _nextRender(0)
+    , _renderSignature(0)
+    , _renderFps(0)
+    , _renderTime(0)
+  #ifndef WLED_DISABLE_2D
+    , _mappingTable(nullptr)
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+    , _paletteCache(nullptr)
+  #endif
     , _default_palette(6)
+    , _dirty(true)
     , _capabilities(0)
     , _t(nullptr)
     {
       DEBUGFX_PRINTF_P(PSTR("-- Creating segment: %p [%d,%d:%d,%d]\n"), this, (int)start, (int)stop, (int)startY, (int)stopY);
       // allocate render buffer (always entire segment), prefer PSRAM if DRAM is running low. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM)
-      pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+      pixels = static_cast<uint32_t*>(allocateBuffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
       if (!pixels) {
         DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
         extern byte errorFlag;
@@ -621,7 +723,13 @@ class Segment {
       endImagePlayback(this);
       #endif
       deallocateData();
-      p_free(pixels);
+      freeBuffer(pixels);
+      #ifndef WLED_DISABLE_2D
+      freeMappingTable();
+      #endif
+      #ifndef WLED_DISABLE_PALETTE_CACHE
+      freePaletteCache();
+      #endif
     }
 
     Segment& operator= (const Segment &orig); // copy assignment
@@ -643,6 +751,8 @@ class Segment {
     inline uint16_t length()               const { return width() * height(); }               // segment length (count) in physical pixels
     inline uint16_t groupLength()          const { return grouping + spacing; }
     inline uint8_t  getLightCapabilities() const { return _capabilities; }
+    inline uint16_t getRenderFps()         const { return (millis() - _lastRender > 2000) ? 0 : (FPS_MULTIPLIER * _renderFps) >> FPS_CALC_SHIFT; } // actual effect frame rate
+    inline uint16_t getRenderTime()        const { return _renderTime; }                      // average effect render time (us)
     inline void     deactivate()                 { setGeometry(0,0); }
     inline Segment &clearName()                  { p_free(name); name = nullptr; return *this; }
     inline Segment &setName(const String &name)  { return setName(name.c_str()); }
@@ -679,7 +789,7 @@ class Segment {
       */
     inline Segment &markForReset() { reset = true; return *this; }  // setOption(SEG_OPTION_RESET, true)
 
-    void startTransition(uint16_t dur, bool segmentCopy = true);    // transition has to start before actual segment values change
+    void startTransition(uint16_t dur, bool segmentCopy = true, bool fxChange = false); // transition has to start before actual segment values change (fxChange: effect will be reset, see createOldSegment())
     uint8_t  currentCCT() const; // current segment's CCT (blended while in transition)
     uint8_t  currentBri() const; // current segment's opacity/brightness (blended while in transition)
 
@@ -821,6 +931,15 @@ class WS2812FX {
 
   public:
 
+#ifdef WLED_ENABLE_FX_BENCHMARK
+    typedef struct FxBenchResult {
+      uint32_t avgUs;     // average effect render time per frame (in us)
+      uint32_t maxUs;     // slowest frame (in us)
+      uint16_t dataLen;   // largest effect data (SEGENV.data) allocation
+      uint16_t dataUsed;  // peak Segment::getUsedSegmentData() while effect was running
+    } fx_bench_t;
+#endif
+
     WS2812FX() :
       now(millis()),
       timebase(0),
@@ -836,6 +955,8 @@ class WS2812FX {
       _pixels(nullptr),
       _pixelCCT(nullptr),
       _suspend(false),
+      _suspendCount(0),
+      _stateReaders(0),
       _brightness(DEFAULT_BRIGHTNESS),
       _length(DEFAULT_LED_COUNT),
       _transitionDur(750),
@@ -846,14 +967,26 @@ class WS2812FX {
       _isOffRefreshRequired(false),
       _hasWhiteChannel(false),
       _triggered(false),
+      _forceFullFrame(true),
+      _overlayDrawn(false),
+      _pixelsWritten(false),
       _segment_index(0),
       _mainSegment(0),
       _modeCount(MODE_COUNT),
       _callback(nullptr),
       customMappingTable(nullptr),
+      customMappingRuns(nullptr),
       customMappingSize(0),
+      customMappingRunCount(0),
       _lastShow(0),
-      _lastServiceShow(0)
+      _lastServiceShow(0),
+      _lastFullShow(0),
+      _frameSignature(0)
+#ifdef WLED_ENABLE_FX_BENCHMARK
+      , _showTime(0)
+      , _framesShown(0)
+      , _framesSkipped(0)
+#endif
     {
       _mode.reserve(_modeCount);     // allocate memory to prevent initial fragmentation (does not increase size())
       _modeData.reserve(_modeCount); // allocate memory to prevent initial fragmentation (does not increase size())
@@ -864,7 +997,7 @@ class WS2812FX {
     ~WS2812FX() {
       p_free(_pixels);
       p_free(_pixelCCT); // just in case
-      d_free(customMappingTable);
+      resetLedmap();
       _mode.clear();
       _modeData.clear();
       _segments.clear();
@@ -895,7 +1028,8 @@ class WS2812FX {
       waitForIt();                                // wait until frame is over (service() has finished or time for 1 frame has passed)
 
     void setRealtimePixelColor(unsigned i, uint32_t c);
-    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) _pixels[n] = c; }  // paints absolute strip pixel with index n and color c
+    void setRealtimePixelColors(unsigned i, const uint8_t *data, unsigned count, unsigned channels = 3); // bulk version: count packed RGB (3 channels) or RGBW (4 channels) pixels
+    inline void setPixelColor(unsigned n, uint32_t c) const   { if (n < getLengthTotal()) { _pixels[n] = c; _pixelsWritten = true; } }  // paints absolute strip pixel with index n and color c
     inline void resetTimebase()                               { timebase = 0UL - millis(); }
     inline void setPixelColor(unsigned n, uint8_t r, uint8_t g, uint8_t b, uint8_t w = 0) const
                                                               { setPixelColor(n, RGBW32(r,g,b,w)); }
@@ -906,8 +1040,10 @@ class WS2812FX {
     inline void setTransition(uint16_t t)                     { _transitionDur = t; } // sets transition time (in ms)
     inline void appendSegment(uint16_t sStart=0, uint16_t sStop=30, uint16_t sStartY = 0, uint16_t sStopY = 1)
                                                               { if (_segments.size() < getMaxSegments()) _segments.emplace_back(sStart,sStop,sStartY,sStopY); }
-    inline void suspend()                                     { _suspend = true; }    // will suspend (and canacel) strip.service() execution
+    inline void suspend()                                     { _suspend = true; _suspendCount++; } // will suspend (and canacel) strip.service() execution
     inline void resume()                                      { _suspend = false; }   // will resume strip.service() execution
+    inline bool beginStateRead()                              { _stateReaders++; if (!_suspend) return true; _stateReaders--; return false; } // segments may be read (without JSON buffer lock) until endStateRead(), fails while strip is suspended
+    inline void endStateRead()                                { _stateReaders--; }
 
     void restartRuntime();
     void setTransitionMode(bool t);
@@ -916,12 +1052,19 @@ class WS2812FX {
     bool hasRGBWBus() const;
     bool hasCCTBus() const;
     bool deserializeMap(unsigned n = 0);
+#ifdef WLED_ENABLE_FX_BENCHMARK
+    bool benchmarkEffect(uint8_t mode, unsigned width, unsigned height, unsigned frames, fx_bench_t &res, uint8_t m12 = UINT8_MAX); // renders effect into scratch segment and measures it (m12: 1D expansion, UINT8_MAX = effect default)
+    inline uint32_t getShowTime() const { return _showTime; } // average show() duration (us)
+    inline uint32_t getFramesShown() const   { return _framesShown; }   // frames blended and sent to buses (since boot)
+    inline uint32_t getFramesSkipped() const { return _framesSkipped; } // unchanged frames sent without blending (damage tracking)
+#endif
 
-    inline bool isUpdating() const           { return !BusManager::canAllShow(); } // return true if the strip is being sent pixel updates
+    inline bool isUpdating() const           { return !BusManager::canAllShow(true); } // return true if the strip is being sent pixel updates (network buses excluded)
     inline bool isServicing() const          { return _isServicing; }           // returns true if strip.service() is executing
     inline bool hasWhiteChannel() const      { return _hasWhiteChannel; }       // returns true if strip contains separate white chanel
     inline bool isOffRefreshRequired() const { return _isOffRefreshRequired; }  // returns true if strip requires regular updates (i.e. TM1814 chipset)
     inline bool isSuspended() const          { return _suspend; }               // returns true if strip.service() execution is suspended
+    inline uint16_t getSuspendCount() const  { return _suspendCount; }          // segments may have changed if this differs from a previous value
     inline bool needsUpdate() const          { return _triggered; }             // returns true if strip received a trigger() request
 
     // uint8_t paletteBlend;  // obsolete - use global paletteBlend instead of strip.paletteBlend
@@ -948,7 +1091,8 @@ class WS2812FX {
     inline uint16_t getLength() const       { return _length; }           // returns actual amount of LEDs on a strip (2D matrix may have less LEDs than W*H)
     inline uint16_t getTransition() const   { return _transitionDur; }    // returns currently set transition time (in ms)
     inline uint16_t getMappedPixelIndex(uint16_t index) const {           // convert logical address to physical
-      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps)) index = customMappingTable[index];
+      if (index < customMappingSize && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps))
+        index = customMappingTable ? customMappingTable[index] : getRunMappedIndex(index);
       return index;
     };
 
@@ -1017,6 +1161,8 @@ class WS2812FX {
     std::vector<Segment> _segments;
 
     volatile bool _suspend;
+    uint16_t _suspendCount;
+    std::atomic<uint8_t> _stateReaders; // readers serializing segments outside of the JSON buffer lock (waitForIt() waits for them)
 
     uint8_t  _brightness;
     uint16_t _length;
@@ -1032,6 +1178,9 @@ class WS2812FX {
       bool _isOffRefreshRequired : 1; //periodic refresh is required for the strip to remain off.
       bool _hasWhiteChannel      : 1;
       bool _triggered            : 1;
+      bool _forceFullFrame       : 1; // next show() must blend and send the whole frame (damage tracking)
+      bool _overlayDrawn         : 1; // show callback (overlay/usermods) wrote into last frame, next frame has to be re-blended
+      mutable bool _pixelsWritten : 1; // setPixelColor() was used since it was last cleared (detects overlay drawing)
     };
 
     uint8_t _segment_index;
@@ -1043,11 +1192,37 @@ class WS2812FX {
 
     show_callback _callback;
 
+    // ledmap is either a flat table or (if it compresses well) runs of consecutive physical indexes, see compressLedmap()
+    typedef struct {
+      uint16_t start;   // logical index of first LED in run (runs are contiguous and cover [0, customMappingSize))
+      uint16_t first;   // physical index of first LED in run (0xFFFF: unmapped)
+      int16_t  step;    // physical index increment: 1, -1 or 0
+    } map_run_t;
     uint16_t* customMappingTable;
+    map_run_t* customMappingRuns;
     uint16_t  customMappingSize;
+    uint16_t  customMappingRunCount;
+
+    void resetLedmap();     // releases ledmap (flat table and runs)
+    void compressLedmap();  // replaces flat table with runs if that saves memory
+    uint16_t getRunMappedIndex(uint16_t index) const;
+#ifndef WLED_DISABLE_SEGMENT_ARENA
+    void initSegmentArena();    // sizes and allocates SegmentArena (FX_arena.cpp)
+    void compactSegmentArena(); // compacts arena if fragmented and segments are idle
+    static bool relocateArenaBlock(const void *from, void *to); // SegmentArena::compact() callback
+#endif
+    bool loadBinaryMap(const char *fileName, unsigned n, size_t jsonSize); // ledmapN.bin, see deserializeMap()
+    void saveBinaryMap(const char *fileName, size_t jsonSize, unsigned width, unsigned height) const;
 
     unsigned long _lastShow;
     unsigned long _lastServiceShow;
+    unsigned long _lastFullShow;    // last time a full (undamaged) frame was sent
+    uint32_t      _frameSignature;  // hash of global & segment parameters affecting blending, used to detect changes not covered by Segment::_dirty
+#ifdef WLED_ENABLE_FX_BENCHMARK
+    uint32_t      _showTime;  // average duration of show() in us
+    uint32_t      _framesShown;
+    uint32_t      _framesSkipped;
+#endif
 
     friend class Segment;
 };
@@ -46,9 +46,7 @@ void WS2812FX::setUpMatrix() {
       return;
     }
 
-    customMappingSize = 0; // prevent use of mapping if anything goes wrong
-
-    d_free(customMappingTable);
+    resetLedmap(); // prevent use of mapping if anything goes wrong
     // Segment::maxWidth and Segment::maxHeight are set according to panel layout
     // and the product will include at least all leds in matrix
     // if actual LEDs are more, getLengthTotal() will return correct number of LEDs
@@ -126,6 +124,7 @@ void WS2812FX::setUpMatrix() {
       }
       DEBUG_PRINTLN();
       #endif
+      compressLedmap(); // panels usually map to a few runs of consecutive LEDs
     } else { // memory allocation error
       DEBUG_PRINTLN(F("ERROR 2D LED map allocation error."));
       isMatrix = false;
@@ -247,44 +246,15 @@ void Segment::blur2D(uint8_t blur_x, uint8_t blur_y, bool smear) const {
   if (!isActive()) return; // not active
   const unsigned cols = vWidth();
   const unsigned rows = vHeight();
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*cols; };
   if (blur_x) {
     const uint8_t keepx = smear ? 255 : 255 - blur_x;
     const uint8_t seepx = blur_x >> 1;
-    for (unsigned row = 0; row < rows; row++) { // blur rows (x direction)
-      // handle first pixel in row to avoid conditional in loop (faster)
-      uint32_t cur = getPixelColorRaw(XY(0, row));
-      uint32_t carryover = fast_color_scale(cur, seepx);
-      setPixelColorRaw(XY(0, row), fast_color_scale(cur, keepx));
-      for (unsigned x = 1; x < cols; x++) {
-         cur = getPixelColorRaw(XY(x, row));
-        uint32_t part = fast_color_scale(cur, seepx);
-        cur = fast_color_scale(cur, keepx);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(x - 1, row), color_add(getPixelColorRaw(XY(x-1, row)), part)); // previous pixel
-        setPixelColorRaw(XY(x, row), cur); // current pixel
-        carryover = part;
-      }
-    }
+    for (unsigned row = 0; row < rows; row++) _dirty |= span_blur(&pixels[row * cols], cols, 1, keepx, seepx); // blur rows (x direction)
   }
   if (blur_y) {
     const uint8_t keepy = smear ? 255 : 255 - blur_y;
     const uint8_t seepy = blur_y >> 1;
-    for (unsigned col = 0; col < cols; col++) {
-      // handle first pixel in column
-      uint32_t cur = getPixelColorRaw(XY(col, 0));
-      uint32_t carryover = fast_color_scale(cur, seepy);
-      setPixelColorRaw(XY(col, 0), fast_color_scale(cur, keepy));
-      for (unsigned y = 1; y < rows; y++) {
-        cur = getPixelColorRaw(XY(col, y));
-        uint32_t part = fast_color_scale(cur, seepy);
-        cur = fast_color_scale(cur, keepy);
-        cur = color_add(cur, carryover);
-        setPixelColorRaw(XY(col, y - 1), color_add(getPixelColorRaw(XY(col, y-1)), part)); // previous pixel
-        setPixelColorRaw(XY(col, y), cur); // current pixel
-        carryover = part;
-      }
-    }
+    _dirty |= span_blur_columns(pixels, cols, rows, keepy, seepy); // blur columns (y direction), processed in tiles of rows
   }
 }
 
@@ -391,29 +361,8 @@ void Segment::moveX(int delta, bool wrap) const {
 
 void Segment::moveY(int delta, bool wrap) const {
   if (!isActive() || !delta) return; // not active
-  const int vW = vWidth();   // segment width in logical pixels (can be 0 if segment is inactive)
-  const int vH = vHeight();  // segment height in logical pixels (is always >= 1)
-  const auto XY = [&](unsigned x, unsigned y){ return x + y*vW; };
-  int absDelta = abs(delta);
-  if (absDelta >= vH) return;
-  uint32_t newPxCol[vH];
-  int newDelta;
-  int stop = vH;
-  int start = 0;
-  if (wrap) newDelta = (delta + vH) % vH; // +rows in case delta < 0
-  else {
-    if (delta < 0) start = absDelta;
-    stop = vH - absDelta;
-    newDelta = delta > 0 ? delta : 0;
-  }
-  for (int x = 0; x < vW; x++) {
-    for (int y = 0; y < stop; y++) {
-      int srcY = y + newDelta;
-      if (wrap) srcY %= vH; // Wrap using modulo when `wrap` is true
-      newPxCol[y] = getPixelColorRaw(XY(x, srcY));
-    }
-    for (int y = 0; y < stop; y++) setPixelColorRaw(XY(x, y + start), newPxCol[y]);
-  }
+  // moving in y direction moves entire rows of the (row major) pixel buffer
+  _dirty |= span_move_rows(pixels, vWidth(), vHeight(), delta, wrap);
 }
 
 // move() - move all pixels in desired direction delta number of pixels
@@ -0,0 +1,175 @@
+/*
+  FX_arena.cpp contains the segment arena (allocator for segment pixel and effect data buffers)
+
+  Licensed under the EUPL v. 1.2 or later
+*/
+#include "wled.h"
+
+#ifndef WLED_DISABLE_SEGMENT_ARENA
+
+/*
+ * Segment arena
+ * Effect data is freed and allocated on every effect change and each transition copies the segment including its
+ * pixel buffer, so over hours of playlist cycling these allocations interleave with web server and network buffers
+ * and leave the heap fragmented. The arena is allocated once and only holds segment buffers; if it gets fragmented
+ * it is compacted between frames (buffers are only accessed through Segment::data and Segment::pixels, effects
+ * already have to cope with data moving as allocateData() may reallocate it).
+ *
+ * Layout: blocks tile the whole arena, each starts with a 4 byte header holding the block size (including header,
+ * multiple of 4) with bit 0 set if the block is in use. Free neighbours are merged on release() and during search.
+ * If the arena is full, allocations fall back to heap (see Segment::allocateBuffer()).
+ */
+
+#define ARENA_HDR       sizeof(uint32_t)
+#define ARENA_USED      1U
+#define ARENA_MIN_SPLIT 16  // do not split off free blocks smaller than this (including header)
+
+uint8_t *SegmentArena::_base     = nullptr;
+size_t   SegmentArena::_size     = 0;
+size_t   SegmentArena::_used     = 0;
+unsigned SegmentArena::_blocks   = 0;
+bool     SegmentArena::_external = false;
+
+static inline uint32_t &blockHeader(uint8_t *p) { return *reinterpret_cast<uint32_t*>(p); }
+static inline size_t blockSize(uint32_t h) { return h & ~ARENA_USED; }
+
+bool SegmentArena::begin(size_t size, bool external) {
+  if (_blocks) return false; // blocks in use cannot be moved to a new arena
+  size &= ~(size_t)3;
+  if (_base && size == _size && external == _external) return true;
+  end();
+  if (size < 1024) return false;
+  _base = static_cast<uint8_t*>(allocate_buffer(size, external ? BFRALLOC_ENFORCE_PSRAM : BFRALLOC_ENFORCE_DRAM));
+  if (!_base) return false;
+  _size = size;
+  _used = 0;
+  _external = external;
+  blockHeader(_base) = size; // one free block
+  return true;
+}
+
+void SegmentArena::end() {
+  if (_blocks) return;
+  p_free(_base);
+  _base = nullptr;
+  _size = 0;
+  _used = 0;
+  _external = false;
+}
+
+void *SegmentArena::allocate(size_t size, bool clear) {
+  if (!_base || size == 0) return nullptr;
+  size_t need = ((size + 3) & ~(size_t)3) + ARENA_HDR;
+  uint8_t *end = _base + _size;
+  for (uint8_t *p = _base; p < end; p += blockSize(blockHeader(p))) {
+    if (blockHeader(p) & ARENA_USED) continue;
+    for (uint8_t *next = p + blockHeader(p); next < end && !(blockHeader(next) & ARENA_USED); next = p + blockHeader(p))
+      blockHeader(p) += blockHeader(next); // merge with following free block
+    size_t len = blockHeader(p);
+    if (len < need) continue;
+    if (len - need >= ARENA_MIN_SPLIT) {
+      blockHeader(p + need) = len - need; // remainder stays free
+      len = need;
+    }
+    blockHeader(p) = len | ARENA_USED;
+    _used += len;
+    _blocks++;
+    if (clear) memset(p + ARENA_HDR, 0, len - ARENA_HDR);
+    return p + ARENA_HDR;
+  }
+  return nullptr;
+}
+
+bool SegmentArena::release(void *ptr) {
+  if (!owns(ptr)) return false;
+  uint8_t *p = static_cast<uint8_t*>(ptr) - ARENA_HDR;
+  if (!(blockHeader(p) & ARENA_USED)) {
+    DEBUGFX_PRINTF_P(PSTR("!!! Arena block %p released twice !!!\n"), ptr);
+    return true;
+  }
+  size_t len = blockSize(blockHeader(p));
+  _used -= len;
+  _blocks--;
+  uint8_t *end = _base + _size;
+  for (uint8_t *next = p + len; next < end && !(blockHeader(next) & ARENA_USED); next = p + len)
+    len += blockHeader(next); // merge with following free block
+  blockHeader(p) = len;
+  return true;
+}
+
+size_t SegmentArena::compact(relocate_cb relocate) {
+  if (!_base) return 0;
+  size_t moved = 0;
+  uint8_t *end = _base + _size;
+  uint8_t *dst = _base; // end of compacted part
+  for (uint8_t *p = _base; p < end; ) {
+    uint32_t h = blockHeader(p);
+    size_t len = blockSize(h);
+    if (h & ARENA_USED) {
+      if (dst != p) {
+        if (relocate(p + ARENA_HDR, dst + ARENA_HDR)) {
+          memmove(dst, p, len); // including header
+          moved += len;
+        } else {
+          blockHeader(dst) = p - dst; // owner unknown: block stays, gap before it remains free
+          dst = p;
+        }
+      }
+      dst += len;
+    }
+    p += len;
+  }
+  if (dst < end) blockHeader(dst) = end - dst;
+  return moved;
+}
+
+size_t SegmentArena::getLargestFree() {
+  size_t largest = 0, run = 0;
+  uint8_t *end = _base + _size;
+  for (uint8_t *p = _base; p && p < end; p += blockSize(blockHeader(p))) {
+    if (blockHeader(p) & ARENA_USED) run = 0;
+    else if ((run += blockHeader(p)) > largest) largest = run;
+  }
+  return largest > ARENA_HDR ? largest - ARENA_HDR : 0;
+}
+
+// arena holds effect data and (if in PSRAM) pixel buffers of all segments plus a transition copy of the largest ones
+// without PSRAM only part of MAX_SEGMENT_DATA is reserved so heap is not drained by unused effect data space
+void WS2812FX::initSegmentArena() {
+  bool external = false;
+  #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+  external = psramFound();
+  #endif
+  #ifdef WLED_SEGMENT_ARENA_SIZE
+  size_t size = WLED_SEGMENT_ARENA_SIZE;
+  #else
+  size_t size = external ? 3 * getLengthTotal() * sizeof(uint32_t) : MAX_SEGMENT_DATA / 4; // PSRAM: pixel buffers only (effect data prefers DRAM)
+  #endif
+  if (!external) while (size >= 2048 && getContiguousFreeHeap() < size + 4*MIN_HEAP_SIZE) size /= 2;
+  if (SegmentArena::begin(size, external))
+    DEBUG_PRINTF_P(PSTR("Segment arena: %uB in %s\n"), SegmentArena::getSize(), external ? "PSRAM" : "DRAM");
+  else
+    DEBUG_PRINTF_P(PSTR("Segment arena not (re)allocated: %uB, %u blocks in use\n"), size, SegmentArena::getBlocks());
+}
+
+void WS2812FX::compactSegmentArena() {
+  static unsigned long lastCheck = 0;
+  if (_suspend || SegmentArena::getBlocks() == 0 || millis() - lastCheck < SEGMENT_ARENA_COMPACT_INTERVAL) return;
+  lastCheck = millis();
+  size_t freeMem = SegmentArena::getSize() - SegmentArena::getUsed();
+  if (SegmentArena::getLargestFree() + ARENA_HDR >= freeMem - freeMem/4) return; // largest free block holds at least 3/4 of free space
+  for (const Segment &seg : _segments) if (seg.isInTransition()) return; // wait until segments are idle (transition copies come and go)
+  size_t moved = SegmentArena::compact(relocateArenaBlock);
+  DEBUG_PRINTF_P(PSTR("Segment arena compacted: %uB moved, largest free %u/%uB\n"), moved, SegmentArena::getLargestFree(), freeMem);
+}
+
+// points segment buffer that starts at "from" to "to", returns false if there is no such segment buffer
+bool WS2812FX::relocateArenaBlock(const void *from, void *to) {
+  for (Segment &seg : strip._segments) {
+    if (seg.data == from)   { seg.data = static_cast<byte*>(to); return true; }
+    if (seg.pixels == from) { seg.pixels = static_cast<uint32_t*>(to); return true; }
+  }
+  return false; // transition copies are not expected (compaction waits for transitions to end), scratch segments are not in _segments
+}
+
+#endif
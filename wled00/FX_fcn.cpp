@@ -12,11 +12,12 @@
 #include "wled.h"
 #include "FXparticleSystem.h"  // TODO: better define the required function (mem service) in FX.h?
 #include "colors.h"
+#include <algorithm>
 
 /*
   Custom per-LED mapping has moved!
 
-  Create a file "ledmap.json" using the edit page.
+  Create a file "ledmap.json" using the edit page (it is converted to "ledmap.bin" on first load).
 
   this is just an example (30 LEDs). It will first set all even, then all uneven LEDs.
   {"map":[
@@ -38,11 +39,18 @@ static_assert(MAX_NUM_SEGMENTS >= WLED_MAX_BUSSES, "Max segments must be at leas
 unsigned      Segment::_usedSegmentData   = 0U; // amount of RAM all segments use for their data[]
 uint16_t      Segment::maxWidth           = DEFAULT_LED_COUNT;
 uint16_t      Segment::maxHeight          = 1;
+#ifndef WLED_DISABLE_2D
+bool          Segment::useMappingTables   = true;
+#endif
 unsigned      Segment::_vLength           = 0;
 unsigned      Segment::_vWidth            = 0;
 unsigned      Segment::_vHeight           = 0;
 uint32_t      Segment::_currentColors[NUM_COLORS] = {0,0,0};
 CRGBPalette16 Segment::_currentPalette    = CRGBPalette16();
+#ifndef WLED_DISABLE_PALETTE_CACHE
+Segment::PaletteCache *Segment::_currentPaletteCache = nullptr;
+bool          Segment::_paletteCacheValid = false;
+#endif
 CRGBPalette16 Segment::_randomPalette     = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 CRGBPalette16 Segment::_newRandomPalette  = generateRandomPalette();  // was CRGBPalette16(DEFAULT_COLOR);
 uint16_t      Segment::_lastPaletteChange = 0; // in seconds; perhaps it should be per segment
@@ -63,10 +71,16 @@ Segment::Segment(const Segment &orig) {
   data = nullptr;
   _dataLen = 0;
   pixels = nullptr;
+  #ifndef WLED_DISABLE_2D
+  _mappingTable = nullptr; // rebuilt on demand
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+  _paletteCache = nullptr; // rebuilt on demand
+  #endif
   if (!stop) return;  // nothing to do if segment is inactive/invalid
   if (orig.pixels) {
     // allocate pixel buffer: prefer IRAM/PSRAM
-    pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    pixels = static_cast<uint32_t*>(allocateBuffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
     if (pixels) {
       memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
       if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
@@ -88,6 +102,12 @@ Segment::Segment(Segment &&orig) noexcept {
   orig.data = nullptr;
   orig._dataLen = 0;
   orig.pixels = nullptr;
+  #ifndef WLED_DISABLE_2D
+  orig._mappingTable = nullptr;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+  orig._paletteCache = nullptr;
+  #endif
 }
 
 // copy assignment
@@ -98,18 +118,30 @@ Segment& Segment::operator= (const Segment &orig) {
     if (name) { p_free(name); name = nullptr; }
     stopTransition(); // delete _t
     deallocateData();
-    p_free(pixels);
+    freeBuffer(pixels);
     pixels = nullptr;
+    #ifndef WLED_DISABLE_2D
+    freeMappingTable();
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_CACHE
+    freePaletteCache();
+    #endif
     // copy source
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     // erase pointers to allocated data
     data = nullptr;
     _dataLen = 0;
+    #ifndef WLED_DISABLE_2D
+    _mappingTable = nullptr; // rebuilt on demand
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_CACHE
+    _paletteCache = nullptr; // rebuilt on demand
+    #endif
     if (!stop) return *this;  // nothing to do if segment is inactive/invalid
     // copy source data
     if (orig.pixels) {
       // allocate pixel buffer: prefer IRAM/PSRAM
-      pixels = static_cast<uint32_t*>(allocate_buffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+      pixels = static_cast<uint32_t*>(allocateBuffer(orig.length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
       if (pixels) {
         memcpy(pixels, orig.pixels, sizeof(uint32_t) * orig.length());
         if (orig.name) { name = static_cast<char*>(allocate_buffer(strlen(orig.name)+1, BFRALLOC_PREFER_PSRAM)); if (name) strcpy(name, orig.name); }
@@ -131,18 +163,50 @@ Segment& Segment::operator= (Segment &&orig) noexcept {
     if (name) { p_free(name); name = nullptr; } // free old name
     stopTransition(); // delete _t
     deallocateData(); // free old runtime data
-    p_free(pixels);   // free old pixel buffer
+    freeBuffer(pixels);   // free old pixel buffer
+    #ifndef WLED_DISABLE_2D
+    freeMappingTable();
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_CACHE
+    freePaletteCache();
+    #endif
     // move source data
     memcpy((void*)this, (void*)&orig, sizeof(Segment));
     orig.name = nullptr;
     orig.data = nullptr;
     orig._dataLen = 0;
     orig.pixels = nullptr;
+    #ifndef WLED_DISABLE_2D
+    orig._mappingTable = nullptr;
+    #endif
+    #ifndef WLED_DISABLE_PALETTE_CACHE
+    orig._paletteCache = nullptr;
+    #endif
     orig._t = nullptr; // old segment cannot be in transition
   }
   return *this;
 }
 
+// allocates pixel or effect data buffer, segment arena is used if it has room (repeated effect changes and transitions do not fragment heap)
+// arena is only used for the memory type it is in: PSRAM arena takes buffers not asking for DRAM (pixel buffers), DRAM arena
+// takes byte accessible buffers (effect data, classic ESP32 keeps pixel buffers in 32 bit only memory); others use allocate_buffer()
+void *Segment::allocateBuffer(size_t len, uint32_t type) {
+  #ifndef WLED_DISABLE_SEGMENT_ARENA
+  if (SegmentArena::isExternal() ? !(type & (BFRALLOC_PREFER_DRAM | BFRALLOC_ENFORCE_DRAM)) : !(type & BFRALLOC_NOBYTEACCESS)) {
+    void *buffer = SegmentArena::allocate(len, type & BFRALLOC_CLEAR);
+    if (buffer) return buffer;
+  }
+  #endif
+  return allocate_buffer(len, type);
+}
+
+void Segment::freeBuffer(void *ptr) {
+  #ifndef WLED_DISABLE_SEGMENT_ARENA
+  if (SegmentArena::release(ptr)) return;
+  #endif
+  p_free(ptr);
+}
+
 // allocates effect data buffer on heap and initialises (erases) it
 bool Segment::allocateData(size_t len) {
   if (len == 0) return false;    // nothing to do
@@ -169,11 +233,11 @@ bool Segment::allocateData(size_t len) {
   #endif
 
   if (data) {
-    d_free(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
+    freeBuffer(data); // free data and try to allocate again (segment buffer may be blocking contiguous heap)
     Segment::addUsedSegmentData(-_dataLen); // subtract buffer size
   }
 
-  data = static_cast<byte*>(allocate_buffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed
+  data = static_cast<byte*>(allocateBuffer(len, BFRALLOC_PREFER_DRAM | BFRALLOC_CLEAR)); // prefer DRAM over PSRAM for speed (arena only if it is in DRAM)
 
   if (data) {
     Segment::addUsedSegmentData(len);
@@ -191,7 +255,7 @@ void Segment::deallocateData() {
   if (!data) { _dataLen = 0; return; }
   if ((Segment::getUsedSegmentData() > 0) && (_dataLen > 0)) { // check that we don't have a dangling / inconsistent data pointer
     //DEBUG_PRINTF_P(PSTR("---  Released data (%p): %d/%d -> %p\n"), this, _dataLen, Segment::getUsedSegmentData(), data);
-    d_free(data);
+    freeBuffer(data);
   } else {
     DEBUG_PRINTF_P(PSTR("---- Released data (%p): inconsistent UsedSegmentData (%d/%d), cowardly refusing to free nothing.\n"), this, _dataLen, Segment::getUsedSegmentData());
   }
@@ -216,6 +280,7 @@ void Segment::resetIfRequired() {
     DEBUG_PRINTF_P(PSTR("-- Segment %p reset, data cleared\n"), this);
   }
   if (pixels) for (size_t i = 0; i < length(); i++) pixels[i] = BLACK; // clear pixel buffer
+  _dirty = true;
   step = 0; call = 0; aux0 = 0; aux1 = 0;
   reset = false;
   #ifdef WLED_ENABLE_GIF
@@ -223,6 +288,40 @@ void Segment::resetIfRequired() {
   #endif
 }
 
+// per-segment frame rate: true if effect has to run in current strip frame, otherwise segment keeps its pixels
+// frameTime is the strip frame time, deadlines are rounded to the nearest strip frame
+bool Segment::isRenderDue(unsigned long t, unsigned frameTime) {
+  if (fps == 0 || call == 0 || isInTransition()) return true; // strip frame rate, first frame after reset or transition in progress
+  if (fps == SEGMENT_FPS_ON_CHANGE) {
+    // FNV-1a over effect parameters (bounds and grouping changes reset the segment, spacing and 1D expansion do not)
+    uint32_t signature = 2166136261UL;
+    const auto hash = [&signature](uint32_t v) { signature = (signature ^ v) * 16777619UL; };
+    for (unsigned i = 0; i < NUM_COLORS; i++) hash(colors[i]);
+    hash(mode | (palette << 8) | (speed << 16) | (intensity << 24));
+    hash(custom1 | (custom2 << 8) | (custom3 << 16) | (check1 << 21) | (check2 << 22) | (check3 << 23));
+    hash(options & 0x3FCEU); // ignore UI only (selected, set) and runtime (freeze, reset) options
+    hash(spacing | (map1D2D << 8));
+    if (signature == _renderSignature && palette != 1) return false; // random palette changes over time
+    _renderSignature = signature;
+    return true;
+  }
+  if (long(t - _nextRender) + long(frameTime / 2) < 0) return false;
+  unsigned period = 1000 / fps;
+  _nextRender += period;
+  if (long(t - _nextRender) >= 0) _nextRender = t + period; // fell behind (e.g. strip slower than segment), do not catch up
+  return true;
+}
+
+void Segment::updateRenderStats(unsigned long t, unsigned us) {
+  unsigned long diff = t - _lastRender;
+  if (diff > 0) {
+    uint32_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math (same as strip FPS)
+    _renderFps = (FPS_CALC_AVG * _renderFps + fpsCurr + FPS_CALC_AVG / 2) / (FPS_CALC_AVG + 1);
+  }
+  _lastRender = t;
+  _renderTime = (FPS_CALC_AVG * unsigned(_renderTime) + min(us, 0xFFFFU)) / (FPS_CALC_AVG + 1);
+}
+
 void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   // there is one randomly generated palette (1) followed by 4 palettes created from segment colors (2-5)
   // those are followed by 7 fastled palettes (6-12) and 59 gradient palettes (13-71)
@@ -287,10 +386,54 @@ void Segment::loadPalette(CRGBPalette16 &targetPalette, uint8_t pal) {
   }
 }
 
+// creates _oldSegment for a transition
+// a full copy duplicates pixel buffer and effect data; if the effect is about to be reset anyway (FX change or pending reset) its
+// data and pixel buffer are handed over to the old segment instead (old effect keeps running there) and this segment only
+// gets a fresh (black) pixel buffer: transition then costs one pixel buffer and no effect data
+Segment *Segment::createOldSegment(bool handOver) {
+  if (!handOver && !reset) return new(std::nothrow) Segment(*this);
+  uint32_t *buffer = static_cast<uint32_t*>(allocateBuffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+  if (!buffer) {
+    DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
+    errorFlag = ERR_NORAM_PX;
+    return nullptr;
+  }
+  // move constructor detaches everything from this segment, keep what is not handed over
+  Transition *t = _t;
+  char *segName = name;
+  #ifndef WLED_DISABLE_2D
+  uint16_t *mappingTable = _mappingTable;
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+  PaletteCache *paletteCache = _paletteCache;
+  #endif
+  Segment *old = new(std::nothrow) Segment(std::move(*this));
+  if (!old) {
+    freeBuffer(buffer);
+    return nullptr; // nothing was moved
+  }
+  _t = t;
+  old->_t = nullptr; // old segment cannot be in transition
+  name = segName;
+  old->name = nullptr;
+  if (name) { old->name = static_cast<char*>(allocate_buffer(strlen(name)+1, BFRALLOC_PREFER_PSRAM)); if (old->name) strcpy(old->name, name); }
+  #ifndef WLED_DISABLE_2D
+  _mappingTable = mappingTable;
+  old->_mappingTable = nullptr; // rebuilt on demand
+  #endif
+  #ifndef WLED_DISABLE_PALETTE_CACHE
+  _paletteCache = paletteCache;
+  old->_paletteCache = nullptr; // rebuilt on demand
+  #endif
+  pixels = buffer; // data stays nullptr until new effect allocates it
+  _dirty = true;
+  return old;
+}
+
 // starting a transition has to occur before change so we get current values 1st
 // note: _t is the temporary segment that holds the values transitioned from (palette, colors, brightness,...) and the current segment holds the "to" values
-//       if this is a non FADE transition or an FX change, the _oldSegment is created which is a full copy of the segment before the change
-void Segment::startTransition(uint16_t dur, bool segmentCopy) {
+//       if this is a non FADE transition or an FX change, the _oldSegment is created which is a copy of the segment before the change (see createOldSegment())
+void Segment::startTransition(uint16_t dur, bool segmentCopy, bool fxChange) {
   if (dur == 0 || !isActive()) {
     if (isInTransition()) _t->_dur = 0;
     return;
@@ -298,7 +441,7 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
   if (isInTransition()) {
     if (segmentCopy && !_t->_oldSegment) {
       // already in transition but segment copy requested and not yet created
-      _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+      _t->_oldSegment = createOldSegment(fxChange); // store/copy current segment settings
       _t->_start = millis(); // restart transition timer
       _t->_dur   = dur;
       _t->_prevPaletteBlends = 0; // reset palette blends
@@ -347,7 +490,7 @@ void Segment::startTransition(uint16_t dur, bool segmentCopy) {
     _t->_palette = palette;
     loadPalette(_t->_palT, palette);
     for (int i=0; i<NUM_COLORS; i++) _t->_colors[i] = colors[i];
-    if (segmentCopy) _t->_oldSegment = new(std::nothrow) Segment(*this); // store/copy current segment settings
+    if (segmentCopy) _t->_oldSegment = createOldSegment(fxChange); // store/copy current segment settings
     if (_t->_oldSegment) {
       DEBUGFX_PRINTF_P(PSTR("-- Started transition: S=%p T(%p) O[%p] OP[%p]\n"), this, _t, _t->_oldSegment, _t->_oldSegment->pixels);
       if (!_t->_oldSegment->isActive()) stopTransition();
@@ -417,8 +560,27 @@ void Segment::beginDraw(uint16_t prog) {
     for (unsigned i = 0; i < noOfBlends; i++, _t->_prevPaletteBlends++) nblendPaletteTowardPalette(_t->_palT, Segment::_currentPalette, 48);
     Segment::_currentPalette = _t->_palT; // copy transitioning/temporary palette
   }
+#ifndef WLED_DISABLE_PALETTE_CACHE
+  // expanded palette: only for segments with enough pixels to make many lookups, entries are rebuilt on first lookup after palette changed
+  _currentPaletteCache = nullptr;
+  if (_isRGB && palette && vLength() >= PALETTE_CACHE_MIN_LENGTH) {
+    if (!_paletteCache) _paletteCache = static_cast<PaletteCache*>(allocate_buffer(sizeof(PaletteCache), WLED_PALETTE_CACHE_ALLOC)); // cleared: matches black palette
+    if (_paletteCache) {
+      _currentPaletteCache = _paletteCache;
+      _paletteCacheValid   = memcmp(&_paletteCache->source, &_currentPalette, sizeof(CRGBPalette16)) == 0;
+    }
+  } else if (_paletteCache) freePaletteCache(); // no longer used (palette, capabilities or size changed)
+#endif
 }
 
+#ifndef WLED_DISABLE_PALETTE_CACHE
+void Segment::buildPaletteCache() {
+  _currentPaletteCache->source = _currentPalette;
+  for (unsigned i = 0; i < 256; i++) _currentPaletteCache->entries[i] = ColorFromPalette(_currentPalette, i, 255, LINEARBLEND);
+  _paletteCacheValid = true;
+}
+#endif
+
 // relies on WS2812FX::service() to call it for each frame
 void Segment::handleRandomPalette() {
   unsigned long now = millis();
@@ -453,7 +615,10 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   #endif
   boundsUnchanged &= (grouping == grp && spacing == spc); // changing grouping and/or spacing changes virtual segment length (painting dimensions)
 
-  if (stop && (spc > 0 || m12 != map1D2D)) clear();
+  if (stop && (spc > 0 || m12 != map1D2D)) {
+    clear();
+    _renderSignature = 0; // pixels are gone, render again even if effect is only rendered on change
+  }
   if (grp) { // prevent assignment of 0
     grouping = grp;
     spacing = spc;
@@ -462,6 +627,9 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     spacing = 0;
   }
   if (ofs < UINT16_MAX) offset = ofs;
+  #ifndef WLED_DISABLE_2D
+  if (!boundsUnchanged || m12 != map1D2D) freeMappingTable(); // rebuilt on demand (dimensions are also checked on use, i.e. for transpose)
+  #endif
   map1D2D  = constrain(m12, 0, 7);
 
   if (boundsUnchanged) return;
@@ -479,7 +647,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     endImagePlayback(this);
     #endif
     deallocateData();
-    p_free(pixels);
+    freeBuffer(pixels);
     pixels = nullptr;
     stop = 0;
     return;
@@ -500,7 +668,7 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
     endImagePlayback(this);
     #endif
     deallocateData();
-    p_free(pixels);
+    freeBuffer(pixels);
     pixels = nullptr;
     stop = 0;
     return;
@@ -508,8 +676,8 @@ void Segment::setGeometry(uint16_t i1, uint16_t i2, uint8_t grp, uint8_t spc, ui
   // allocate FX render buffer
   if (length() != oldLength) {
     // allocate render buffer (always entire segment), prefer IRAM/PSRAM. Note: impact on FPS with PSRAM buffer is low (<2% with QSPI PSRAM) on S2/S3
-    p_free(pixels);
-    pixels = static_cast<uint32_t*>(allocate_buffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
+    freeBuffer(pixels);
+    pixels = static_cast<uint32_t*>(allocateBuffer(length() * sizeof(uint32_t), BFRALLOC_PREFER_PSRAM | BFRALLOC_NOBYTEACCESS));
     if (!pixels) {
       DEBUGFX_PRINTLN(F("!!! Not enough RAM for pixel buffer !!!"));
       #ifdef WLED_ENABLE_GIF
@@ -581,7 +749,7 @@ Segment &Segment::setMode(uint8_t fx, bool loadDefaults) {
   if (fx >= strip.getModeCount()) fx = 0; // set solid mode
   // if we have a valid mode & is not reserved
   if (fx != mode) {
-    startTransition(strip.getTransition(), true); // set effect transitions (must create segment copy)
+    startTransition(strip.getTransition(), true, true); // set effect transitions (old segment takes over effect data, segment is reset below)
     mode = fx;
     int sOpt;
     // load default values from effect string
@@ -679,6 +847,210 @@ static void setPinwheelParameters(int i, int vW, int vH, int& startx, int& start
   startx = (vW * Fixed_Scale) / 2; // + cosVal[0] / 4; // starting position = center + 1/4 pixel (in fixed point)
   starty = (vH * Fixed_Scale) / 2; // + sinVal[0] / 4;
 }
+
+// pixels of 1D index i in "Arc" expansion (may contain duplicates and pixels outside of segment)
+template<typename F> static void forEachArcPixel(int i, F &&pixel) {
+  if (i == 0) { pixel(0, 0); return; }
+  float r = i;
+  float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
+  for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
+    int x = roundf(sin_t(rad) * r);
+    int y = roundf(cos_t(rad) * r);
+    // exploit symmetry
+    pixel(x, y);
+    pixel(y, x);
+  }
+  // Bresenham’s Algorithm (may not fill every pixel)
+  //int d = 3 - (2*i);
+  //int y = i, x = 0;
+  //while (y >= x) {
+  //  pixel(x, y);
+  //  pixel(y, x);
+  //  x++;
+  //  if (d > 0) {
+  //    y--;
+  //    d += 4 * (x - y) + 10;
+  //  } else {
+  //    d += 4 * x + 6;
+  //  }
+  //}
+}
+
+// Pinwheel rays share their edge lines: a pixel on line 1 (2) is skipped if the adjacent ray before (after) was drawn just before
+#define PINWHEEL_LINE1 0x01
+#define PINWHEEL_LINE2 0x02
+static inline bool drawPinwheelPixel(unsigned flags, bool drawFirst, bool drawLast) {
+  return (!(flags & PINWHEEL_LINE1) || drawFirst) && (!(flags & PINWHEEL_LINE2) || drawLast);
+}
+
+// pixels of ray i in "Pinwheel" expansion with PINWHEEL_LINE flags (see drawPinwheelPixel())
+// Uses Bresenham's algorithm to place coordinates of two lines in arrays then fills the blocks between them
+template<typename F> static void forEachPinwheelPixel(int i, int vW, int vH, F &&pixel) {
+  int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
+  setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
+
+  unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
+  uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
+  int lineLength[2] = {0};
+  int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
+
+  for (int lineNr = 0; lineNr < 2; lineNr++) {
+    int x0 = startX; // x, y coordinates in fixed scale
+    int y0 = startY;
+    int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
+    int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
+    const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
+    const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
+    uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
+    int* length = &lineLength[lineNr];          // faster access
+    x0 /= Fixed_Scale; // convert to pixel coordinates
+    y0 /= Fixed_Scale;
+
+    // Bresenham's algorithm
+    int idx = 0;
+    int err = dx + dy;
+    while (true) {
+      if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
+        closestEdgeIdx = min(closestEdgeIdx, idx-2);
+        break; // stop if outside of grid (exploit unsigned int overflow)
+      }
+      coordinates[idx++] = x0;
+      coordinates[idx++] = y0;
+      (*length)++;
+      // note: since endpoint is out of grid, no need to check if endpoint is reached
+      int e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+
+  // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
+  int diff = lineLength[0] - lineLength[1];
+  int longLineIdx = (diff > 0) ? 0 : 1;
+  int shortLineIdx = longLineIdx ? 0 : 1;
+  if (diff != 0) {
+    int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
+    int lastX = lineCoords[shortLineIdx][idx++];
+    int lastY = lineCoords[shortLineIdx][idx++];
+    bool keepX = lastX == 0 || lastX == vW - 1;
+    for (int d = 0; d < abs(diff); d++) {
+      lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
+      idx++;
+      lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
+      idx++;
+    }
+  }
+
+  // block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
+  closestEdgeIdx += 2;
+  for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
+    int x1 = lineCoords[0][idx];
+    int x2 = lineCoords[1][idx++];
+    int y1 = lineCoords[0][idx];
+    int y2 = lineCoords[1][idx++];
+    int minX, maxX, minY, maxY;
+    (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
+    (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
+
+    bool alwaysDraw = (idx > closestEdgeIdx) || // Edge pixels on uneven lines are always drawn
+                      (i == 0 && idx == 2);     // Center pixel special case
+    for (int x = minX; x <= maxX; x++) {
+      for (int y = minY; y <= maxY; y++) {
+        unsigned flags = 0;
+        if (!alwaysDraw) {
+          if (x == x1 && y == y1) flags |= PINWHEEL_LINE1;
+          if (x == x2 && y == y2) flags |= PINWHEEL_LINE2;
+        }
+        pixel(x, y, flags);
+      }
+    }
+  }
+}
+
+template<typename F> static void forEachMappedPixel(uint8_t m12, int i, int vW, int vH, F &&pixel) {
+  switch (m12) {
+    case M12_pArc:      forEachArcPixel(i, [&](int x, int y) { pixel(x, y, 0); }); break;
+    case M12_sPinwheel: forEachPinwheelPixel(i, vW, vH, pixel); break;
+  }
+}
+
+// Mapping table for expensive 1D->2D expansions (Arc, Pinwheel), turns setPixelColor() into a lookup of pixel indexes.
+// Note: "Corner" is only two loops, a table lookup is not faster.
+// Layout: header {map1D2D, vW, vH, vLen}, vLen+1 offsets into entries, entries (pixel index | pinwheel flags)
+// A header-only table (M12_TABLE_NONE) marks segments too large for a table, mapping is computed then.
+#define M12_TABLE_HEADER 4
+#define M12_TABLE_NONE   0x8000
+#define M12_TABLE_FLAGS  14     // pinwheel flags are stored in upper 2 bits
+#define M12_TABLE_INDEX  0x3FFF // max. 16384 pixels
+
+// table entries of index i without duplicates (sorted, drawing order does not matter), returns number of entries
+static unsigned getMappedPixels(uint8_t m12, int i, int vW, int vH, std::vector<uint16_t> &pixels) {
+  pixels.clear();
+  forEachMappedPixel(m12, i, vW, vH, [&](int x, int y, unsigned flags) {
+    if ((unsigned)x < (unsigned)vW && (unsigned)y < (unsigned)vH) pixels.push_back((x + y * vW) | (flags << M12_TABLE_FLAGS));
+  });
+  std::sort(pixels.begin(), pixels.end());
+  pixels.erase(std::unique(pixels.begin(), pixels.end()), pixels.end());
+  return pixels.size();
+}
+
+void Segment::freeMappingTable() const {
+  p_free(_mappingTable);
+  _mappingTable = nullptr;
+}
+
+const uint16_t *Segment::getMappingTable(int vW, int vH) const {
+  if (!useMappingTables) return nullptr;
+  const unsigned vLen = vLength();
+  const uint16_t *t = _mappingTable;
+  if (t && (t[0] & ~M12_TABLE_NONE) == map1D2D && t[1] == vW && t[2] == vH && t[3] == vLen) // also detects transpose
+    return (t[0] & M12_TABLE_NONE) ? nullptr : t;
+  freeMappingTable();
+
+  // number of entries without duplicates (arc draws some pixels more than once)
+  std::vector<uint16_t> pixels;
+  size_t count = 0;
+  if (vW * vH <= M12_TABLE_INDEX + 1) {
+    for (unsigned i = 0; i < vLen && count <= UINT16_MAX; i++) count += getMappedPixels(map1D2D, i, vW, vH, pixels);
+  }
+  size_t size = M12_TABLE_HEADER;
+  uint16_t *table = nullptr;
+  if (count && count <= UINT16_MAX) {
+    size += vLen + 1 + count;
+    // table is optional: do not use heap needed by web server, mapping is computed if there is no table
+    #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+    if (!psramFound())
+    #endif
+    if (getContiguousFreeHeap() < size * sizeof(uint16_t) + MIN_HEAP_SIZE) size = M12_TABLE_HEADER;
+  }
+  if (size > M12_TABLE_HEADER) table = static_cast<uint16_t*>(allocate_buffer(size * sizeof(uint16_t), BFRALLOC_PREFER_PSRAM));
+  if (!table) {
+    size = M12_TABLE_HEADER;
+    table = static_cast<uint16_t*>(allocate_buffer(size * sizeof(uint16_t), BFRALLOC_PREFER_PSRAM));
+    if (!table) return nullptr;
+  }
+  table[0] = map1D2D | (size == M12_TABLE_HEADER ? M12_TABLE_NONE : 0);
+  table[1] = vW;
+  table[2] = vH;
+  table[3] = vLen;
+  _mappingTable = table;
+  if (size == M12_TABLE_HEADER) {
+    DEBUGFX_PRINTF_P(PSTR("No mapping table for %dx%d.\n"), vW, vH);
+    return nullptr;
+  }
+
+  uint16_t *offsets = table + M12_TABLE_HEADER;
+  uint16_t *entries = offsets + vLen + 1;
+  unsigned n = 0;
+  for (unsigned i = 0; i < vLen; i++) {
+    offsets[i] = n;
+    n += getMappedPixels(map1D2D, i, vW, vH, pixels);
+    std::copy(pixels.begin(), pixels.end(), entries + offsets[i]);
+  }
+  offsets[vLen] = n;
+  DEBUGFX_PRINTF_P(PSTR("Mapping table for %dx%d: %u entries.\n"), vW, vH, n);
+  return table;
+}
 #endif
 
 // 1D strip
@@ -775,133 +1147,33 @@ void WLED_O2_ATTR Segment::setPixelColor(int i, uint32_t col) const
         if (vStrip > 0)                   setPixelColorRaw(XY(vStrip - 1, vH - i - 1), col);
         else for (int x = 0; x < vW; x++) setPixelColorRaw(XY(x, vH - i - 1), col);
         break;
-      case M12_pArc:
-        // expand in circular fashion from center
-        if (i == 0)
-          setPixelColorRaw(XY(0, 0), col);
-        else {
-          float r = i;
-          float step = HALF_PI / (2.8284f * r + 4); // we only need (PI/4)/(r/sqrt(2)+1) steps
-          for (float rad = 0.0f; rad <= (HALF_PI/2)+step/2; rad += step) {
-            int x = roundf(sin_t(rad) * r);
-            int y = roundf(cos_t(rad) * r);
-            // exploit symmetry
-            setPixelColorXY(x, y, col);
-            setPixelColorXY(y, x, col);
-          }
-          // Bresenham’s Algorithm (may not fill every pixel)
-          //int d = 3 - (2*i);
-          //int y = i, x = 0;
-          //while (y >= x) {
-          //  setPixelColorXY(x, y, col);
-          //  setPixelColorXY(y, x, col);
-          //  x++;
-          //  if (d > 0) {
-          //    y--;
-          //    d += 4 * (x - y) + 10;
-          //  } else {
-          //    d += 4 * x + 6;
-          //  }
-          //}
-        }
-        break;
       case M12_pCorner:
         for (int x = 0; x <= i; x++) setPixelColorXY(x, i, col); // note: <= to include i=0. Relies on overflow check in sPC()
         for (int y = 0; y <  i; y++) setPixelColorXY(i, y, col);
         break;
-      case M12_sPinwheel: {
-        // Uses Bresenham's algorithm to place coordinates of two lines in arrays then draws between them
-        int startX, startY, cosVal[2], sinVal[2]; // in fixed point scale
-        setPinwheelParameters(i, vW, vH, startX, startY, cosVal, sinVal);
-
-        unsigned maxLineLength = max(vW, vH) + 2; // pixels drawn is always smaller than dx or dy, +1 pair for rounding errors
-        uint16_t lineCoords[2][maxLineLength];    // uint16_t to save ram
-        int lineLength[2] = {0};
-
+      case M12_pArc:      // expand in circular fashion from center
+      case M12_sPinwheel: { // rays from center
         static int prevRays[2] = {INT_MAX, INT_MAX}; // previous two ray numbers
-        int closestEdgeIdx = INT_MAX; // index of the closest edge pixel
-
-        for (int lineNr = 0; lineNr < 2; lineNr++) {
-          int x0 = startX; // x, y coordinates in fixed scale
-          int y0 = startY;
-          int x1 = (startX + (cosVal[lineNr] << 9)); // outside of grid
-          int y1 = (startY + (sinVal[lineNr] << 9)); // outside of grid
-          const int dx =  abs(x1-x0), sx = x0<x1 ? 1 : -1; // x distance & step
-          const int dy = -abs(y1-y0), sy = y0<y1 ? 1 : -1; // y distance & step
-          uint16_t* coordinates = lineCoords[lineNr]; // 1D access is faster
-          int* length = &lineLength[lineNr];          // faster access
-          x0 /= Fixed_Scale; // convert to pixel coordinates
-          y0 /= Fixed_Scale;
-
-          // Bresenham's algorithm
-          int idx = 0;
-          int err = dx + dy;
-          while (true) {
-            if ((unsigned)x0 >= (unsigned)vW || (unsigned)y0 >= (unsigned)vH) {
-              closestEdgeIdx = min(closestEdgeIdx, idx-2);
-              break; // stop if outside of grid (exploit unsigned int overflow)
-            }
-            coordinates[idx++] = x0;
-            coordinates[idx++] = y0;
-            (*length)++;
-            // note: since endpoint is out of grid, no need to check if endpoint is reached
-            int e2 = 2 * err;
-            if (e2 >= dy) { err += dy; x0 += sx; }
-            if (e2 <= dx) { err += dx; y0 += sy; }
+        bool drawFirst = true, drawLast = true;
+        if (map1D2D == M12_sPinwheel) {
+          int max_i = getPinwheelLength(vW, vH) - 1;
+          if (i != prevRays[1]) { // effect drawing twice in 1 frame draws all pixels
+            drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
+            drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
           }
+          prevRays[1] = prevRays[0];
+          prevRays[0] = i;
         }
-
-        // fill up the shorter line with missing coordinates, so block filling works correctly and efficiently
-        int diff = lineLength[0] - lineLength[1];
-        int longLineIdx = (diff > 0) ? 0 : 1;
-        int shortLineIdx = longLineIdx ? 0 : 1;
-        if (diff != 0) {
-          int idx = (lineLength[shortLineIdx] - 1) * 2; // last valid coordinate index
-          int lastX = lineCoords[shortLineIdx][idx++];
-          int lastY = lineCoords[shortLineIdx][idx++];
-          bool keepX = lastX == 0 || lastX == vW - 1;
-          for (int d = 0; d < abs(diff); d++) {
-            lineCoords[shortLineIdx][idx] = keepX ? lastX :lineCoords[longLineIdx][idx];
-            idx++;
-            lineCoords[shortLineIdx][idx] =  keepX ? lineCoords[longLineIdx][idx] : lastY;
-            idx++;
-          }
-        }
-
-        // draw and block-fill the line coordinates. Note: block filling only efficient if angle between lines is small
-        closestEdgeIdx += 2;
-        int max_i = getPinwheelLength(vW, vH) - 1;
-        bool drawFirst = !(prevRays[0] == i - 1 || (i == 0 && prevRays[0] == max_i)); // draw first line if previous ray was not adjacent including wrap
-        bool drawLast  = !(prevRays[0] == i + 1 || (i == max_i && prevRays[0] == 0)); // same as above for last line
-        for (int idx = 0; idx < lineLength[longLineIdx] * 2;) { //!! should be long line idx!
-          int x1 = lineCoords[0][idx];
-          int x2 = lineCoords[1][idx++];
-          int y1 = lineCoords[0][idx];
-          int y2 = lineCoords[1][idx++];
-          int minX, maxX, minY, maxY;
-          (x1 < x2) ? (minX = x1, maxX = x2) : (minX = x2, maxX = x1);
-          (y1 < y2) ? (minY = y1, maxY = y2) : (minY = y2, maxY = y1);
-
-          // fill the block between the two x,y points
-          bool alwaysDraw = (drawFirst && drawLast) || // No adjacent rays, draw all pixels
-                            (idx > closestEdgeIdx)  || // Edge pixels on uneven lines are always drawn
-                            (i == 0 && idx == 2)    || // Center pixel special case
-                            (i == prevRays[1]);        // Effect drawing twice in 1 frame
-          for (int x = minX; x <= maxX; x++) {
-            for (int y = minY; y <= maxY; y++) {
-              bool onLine1 = x == x1 && y == y1;
-              bool onLine2 = x == x2 && y == y2;
-              if ((alwaysDraw) ||
-                  (!onLine1 && (!onLine2 || drawLast))  || // Middle pixels and line2 if drawLast
-                  (!onLine2 && (!onLine1 || drawFirst))    // Middle pixels and line1 if drawFirst
-                ) {
-                setPixelColorXY(x, y, col);
-              }
-            }
+        if (const uint16_t *table = getMappingTable(vW, vH)) {
+          const uint16_t *offsets = table + M12_TABLE_HEADER;
+          const uint16_t *entries = offsets + vL + 1;
+          for (unsigned k = offsets[i]; k < offsets[i+1]; k++) {
+            unsigned e = entries[k];
+            if (drawPinwheelPixel(e >> M12_TABLE_FLAGS, drawFirst, drawLast)) setPixelColorRaw(e & M12_TABLE_INDEX, col);
           }
-        }
-        prevRays[1] = prevRays[0];
-        prevRays[0] = i;
+        } else forEachMappedPixel(map1D2D, i, vW, vH, [&](int x, int y, unsigned flags) {
+          if (drawPinwheelPixel(flags, drawFirst, drawLast)) setPixelColorXY(x, y, col);
+        });
         break;
       }
     }
@@ -1052,7 +1324,7 @@ void Segment::refreshLightCapabilities() const {
  */
 void Segment::fill(uint32_t c) const {
   if (!isActive()) return; // not active
-  for (unsigned i = 0; i < length(); i++) setPixelColorRaw(i,c); // always fill all pixels (blending will take care of grouping, spacing and clipping)
+  _dirty |= span_fill(pixels, length(), c); // always fill all pixels (blending will take care of grouping, spacing and clipping)
 }
 
 /*
@@ -1063,38 +1335,21 @@ void Segment::fill(uint32_t c) const {
 void Segment::fade_out(uint8_t rate) const {
   if (!isActive()) return; // not active
   rate = (256-rate) >> 1;
-  const int mappedRate = 256 / (rate + 1);
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned j = 0; j < rlength; j++) {
-    uint32_t color = getPixelColorRaw(j);
-    if (color == colors[1]) continue; // already at target color
-    for (int i = 0; i < 32; i += 8) {
-      uint8_t c2 = (colors[1]>>i);  // get background channel
-      uint8_t c1 = (color>>i);      // get foreground channel
-      // we can't use bitshift since we are using int
-      int delta = (c2 - c1) * mappedRate / 256;
-      // if fade isn't complete, make sure delta is at least 1 (fixes rounding issues)
-      if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
-      // stuff new value back into color
-      color &= ~(0xFF<<i);
-      color |= ((c1 + delta) & 0xFF) << i;
-    }
-    setPixelColorRaw(j, color);
-  }
+  const unsigned mappedRate = 256 / (rate + 1);
+  // each channel moves mappedRate/256 toward background color, at least by 1 (fixes rounding issues)
+  _dirty |= span_fade_toward(pixels, rawLength(), colors[1], mappedRate);
 }
 
 // fades all pixels to secondary color
 void Segment::fadeToSecondaryBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, color_blend(getPixelColorRaw(i), colors[1], fadeBy));
+  _dirty |= span_blend_color(pixels, rawLength(), colors[1], fadeBy);
 }
 
 // fades all pixels to black using nscale8()
 void Segment::fadeToBlackBy(uint8_t fadeBy) const {
   if (!isActive() || fadeBy == 0) return;   // optimization - no scaling to apply
-  const size_t rlength = rawLength();  // calculate only once
-  for (unsigned i = 0; i < rlength; i++) setPixelColorRaw(i, fast_color_scale(getPixelColorRaw(i), 255-fadeBy));
+  _dirty |= span_scale(pixels, rawLength(), 255-fadeBy);
 }
 
 /*
@@ -1113,20 +1368,7 @@ void Segment::blur(uint8_t blur_amount, bool smear) const {
 #endif
   uint8_t keep = smear ? 255 : 255 - blur_amount;
   uint8_t seep = blur_amount >> 1;
-  unsigned vlength = vLength();
-  // handle first pixel to avoid conditional in loop (faster)
-  uint32_t cur = getPixelColorRaw(0);
-  uint32_t carryover = fast_color_scale(cur, seep);
-  setPixelColorRaw(0, fast_color_scale(cur, keep));
-  for (unsigned i = 1; i < vlength; i++) {
-    cur = getPixelColorRaw(i);
-    uint32_t part = fast_color_scale(cur, seep);
-    cur = fast_color_scale(cur, keep);
-    cur = color_add(cur, carryover);
-    setPixelColorRaw(i - 1, color_add(getPixelColorRaw(i - 1), part)); // previous pixel
-    setPixelColorRaw(i, cur); // current pixel
-    carryover = part;
-  }
+  _dirty |= span_blur(pixels, vLength(), 1, keep, seep);
 }
 
 /*
@@ -1168,7 +1410,18 @@ uint32_t Segment::color_from_palette(uint16_t i, bool mapping, bool moving, uint
     case 1: blend = LINEARBLEND; break;
     case 2: blend = LINEARBLEND_NOWRAP; break;
   }
-  CRGBW palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
+  CRGBW palcol;
+#ifndef WLED_DISABLE_PALETTE_CACHE
+  if (_currentPaletteCache) {
+    // same result as ColorFromPalette(): other blend types are LINEARBLEND with remapped index, brightness is applied like color_fade()
+    if (!_paletteCacheValid) buildPaletteCache();
+    if (blend == LINEARBLEND_NOWRAP) paletteIndex = (paletteIndex * 0xF0) >> 8;
+    else if (blend == NOBLEND)       paletteIndex &= 0xF0;
+    palcol = _currentPaletteCache->entries[paletteIndex & 0xFF];
+    if (pbri < 255) palcol = color_fade(palcol, pbri);
+  } else
+#endif
+  palcol = ColorFromPalette(_currentPalette, paletteIndex, pbri, blend);
   palcol.w = W(color);
 
   return palcol.color32;
@@ -1291,6 +1544,9 @@ void WS2812FX::finalizeInit() {
 
   // allocate frame buffer after matrix has been set up (gaps!)
   updatePixelBuffer();
+#ifndef WLED_DISABLE_SEGMENT_ARENA
+  initSegmentArena(); // after global buffers so arena size can respect remaining heap
+#endif
   DEBUG_PRINTF_P(PSTR("Heap after strip init: %uB\n"), getFreeHeapSize());
 }
 
@@ -1300,6 +1556,7 @@ void WS2812FX::updatePixelBuffer() {
   p_free(_pixels); // using realloc on large buffers can cause additional fragmentation instead of reducing it
   // use PSRAM if available: there is no measurable perfomance impact between PSRAM and DRAM on S2/S3 with QSPI PSRAM for this buffer
   _pixels = static_cast<uint32_t*>(allocate_buffer(requiredMem, BFRALLOC_ENFORCE_PSRAM | BFRALLOC_NOBYTEACCESS | BFRALLOC_CLEAR));
+  _forceFullFrame = true;
   DEBUG_PRINTF_P(PSTR("strip buffer size: %uB\n"), requiredMem);
 }
 
@@ -1329,7 +1586,8 @@ void WS2812FX::service() {
       // current segment is active -> re-run effect, and remember that show() call is necessary
       // if we arrive here, its always showtime (timeToShow == true)
       doShow = true;
-      if (!seg.freeze) { //only run effect function if not frozen
+      if (!seg.freeze && seg.isRenderDue(nowUp, _frametime)) { //only run effect function if not frozen and segment frame is due
+        unsigned long renderStart = micros();
         // Effect blending
         uint16_t prog = seg.progress();
         seg.beginDraw(prog);                // set up parameters for get/setPixelColor() (will also blend colors and palette if blend style is FADE)
@@ -1350,6 +1608,7 @@ void WS2812FX::service() {
           segO->call++;                     // increment old mode run counter
           Segment::modeBlend(false);        // unset flag
         }
+        seg.updateRenderStats(nowUp, micros() - renderStart);
       }
     }
   }
@@ -1370,6 +1629,9 @@ void WS2812FX::service() {
   #endif
 
   if (!_suspend) _triggered = false; // avoid losing "trigger" events if suspend requested during effect service()
+#ifndef WLED_DISABLE_SEGMENT_ARENA
+  compactSegmentArena(); // no effect is running, segment buffers can be moved
+#endif
   _isServicing = false;
 }
 
@@ -1463,6 +1725,10 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
         for (int y = 0; y < height; y++) {
           uint32_t* pRow = &_pixels[start_offset + y * y_inc];
           const int y_width = y * width;
+          if (blendMode == 0) { // top: plain opacity blend of whole row
+            span_blend(pRow, x_inc, topSegment.getPixelsRaw() + y_width, width, opacity);
+            continue;
+          }
           for (int x = 0; x < width; x++) {
             uint32_t* p = pRow + x * x_inc;
             uint32_t c_a = topSegment.getPixelColorRaw(x + y_width);
@@ -1487,6 +1753,18 @@ void WS2812FX::blendSegment(const Segment &topSegment) const {
       uint32_t* strip = _pixels;
       int start = topSegment.start;
       int off   = topSegment.offset;
+      if (blendMode == 0 && off < length) { // top: segment maps to (at most) two contiguous runs due to offset wrap
+        const uint32_t *src = topSegment.getPixelsRaw();
+        if (!topSegment.reverse) {
+          span_blend(&strip[start + off], 1, src, length - off, opacity);
+          if (off) span_blend(&strip[start], 1, src + length - off, off, opacity);
+        } else {
+          if (off) span_blend(&strip[start + off - 1], -1, src, off, opacity);
+          span_blend(&strip[start + length - 1], -1, src + off, length - off, opacity);
+        }
+        if (_pixelCCT) memset(&_pixelCCT[start], cct, length);
+        return;
+      }
       for (int i = 0; i < length; i++) {
         uint32_t c_a = topSegment.getPixelColorRaw(i);
         int p = topSegment.reverse ? (length - i - 1) : i;
@@ -1732,27 +2010,76 @@ void WS2812FX::show() {
 
   unsigned long showNow = millis();
   size_t diff = showNow - _lastShow;
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  uint32_t showStart = micros();
+  #endif
 
   size_t totalLen = getLengthTotal();
+  bool blendSegments = realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE;
+  // avoid race condition, capture _callback value
+  show_callback callback = _callback;
+
+  // damage tracking: any change in segment geometry, options, opacity, brightness, etc. (or a transition) requires a full frame
+  // otherwise only segments whose pixels changed since last show() (Segment::_dirty) are part of the damaged range
+  // a full frame is sent at least every FULL_FRAME_INTERVAL to keep network receivers (and other outputs) alive
+  // if the overlay drew into last frame, _pixels have to be re-blended to redraw (or remove) it
+  bool fullFrame = !blendSegments || _overlayDrawn || _triggered || _forceFullFrame || _isOffRefreshRequired || (showNow - _lastFullShow >= FULL_FRAME_INTERVAL);
+  uint32_t signature = 2166136261UL; // FNV-1a
+  const auto hash = [&signature](uint32_t v) { signature = (signature ^ v) * 16777619UL; };
+  hash(_brightness | (gammaCorrectCol << 8) | (correctWB << 9) | (cctFromRgb << 10) | (Bus::getGlobalAWMode() << 16) | (uint8_t(Bus::getCCTBlend()) << 24));
+  hash(Bus::getCCT() | (blendingStyle << 16) | (_segments.size() << 24));
+  size_t dmgStart = totalLen, dmgStop = 0;
+  for (const Segment &seg : _segments) {
+    hash(seg.start | (seg.stop << 16));
+    hash(seg.startY | (seg.stopY << 16));
+    hash(seg.offset | (seg.grouping << 16) | (seg.spacing << 24));
+    hash((seg.options & 0x3FCEU) | (seg.blendMode << 16) | (seg.isActive() << 24)); // ignore UI only (selected, set) and runtime (freeze, reset) options
+    hash(seg.currentBri() | (seg.currentCCT() << 8));
+    if (seg.isInTransition()) fullFrame = true;
+    if (seg._dirty && seg.isActive()) {
+      size_t first = seg.start + seg.startY * Segment::maxWidth;
+      size_t last  = seg.stop  + (seg.stopY - 1) * Segment::maxWidth; // exclusive
+      if (first < dmgStart) dmgStart = first;
+      if (last  > dmgStop)  dmgStop  = last;
+    }
+  }
+  if (signature != _frameSignature) fullFrame = true;
+  _frameSignature = signature;
+
+  // nothing changed since last frame: frame buffer already holds blended segments, skip blending (overlay and buses are still updated)
+  // per pixel CCT is only known while blending, CCT setups always blend
+  const bool needCCT = (hasCCTBus() || correctWB) && !cctFromRgb;
+  const bool unchanged = !fullFrame && dmgStart >= dmgStop && !needCCT;
+  if (fullFrame) {
+    dmgStart = 0;
+    dmgStop  = totalLen;
+    _lastFullShow = showNow;
+    _forceFullFrame = false;
+  }
+
   // WARNING: as WLED doesn't handle CCT on pixel level but on Segment level instead
   // we need to keep track of each pixel's CCT when blending segments (if CCT is present)
   // and then set appropriate CCT from that pixel during paint (see below).
-  if ((hasCCTBus() || correctWB) && !cctFromRgb)
+  if (needCCT)
     _pixelCCT = static_cast<uint8_t*>(allocate_buffer(totalLen * sizeof(uint8_t), BFRALLOC_PREFER_PSRAM)); // allocate CCT buffer if necessary, prefer PSRAM
   if (_pixelCCT) memset(_pixelCCT, 127, totalLen); // set neutral (50:50) CCT
 
-  if (realtimeMode == REALTIME_MODE_INACTIVE || useMainSegmentOnly || realtimeOverride > REALTIME_OVERRIDE_NONE) {
+  if (blendSegments && !unchanged) {
     // clear frame buffer
     memset(_pixels, 0, sizeof(uint32_t) * totalLen);
-    // blend all segments into (cleared) buffer
+    // blend all segments into (cleared) buffer (overlapping segments need to be re-blended even if unchanged)
     for (Segment &seg : _segments) if (seg.isActive() && (seg.on || seg.isInTransition())) {
       blendSegment(seg);              // blend segment's buffer into frame buffer
     }
   }
+  for (Segment &seg : _segments) seg._dirty = false;
 
-  // avoid race condition, capture _callback value
-  show_callback callback = _callback;
-  if (callback) callback(); // will call setPixelColor or setRealtimePixelColor
+  if (callback) {
+    _pixelsWritten = false;
+    callback(); // will call setPixelColor or setRealtimePixelColor
+    _overlayDrawn = _pixelsWritten;
+    if (_overlayDrawn && unchanged) { dmgStart = 0; dmgStop = totalLen; } // overlay drew into unchanged frame (it is re-blended next frame)
+  }
 
   // paint actual pixels
   int oldCCT = Bus::getCCT(); // store original CCT value (since it is global)
@@ -1761,7 +2088,15 @@ void WS2812FX::show() {
   // use color gamma correction if enabled, not in realtime mode with gamma disabled or currently overriding RT mode
   bool useGammaCorrection = gammaCorrectCol && !(realtimeMode && arlsDisableGammaCorrection && !realtimeOverride);
 
-  for (size_t i = 0; i < totalLen; i++) {
+  bool useLedmap = customMappingSize > 0 && (realtimeMode == REALTIME_MODE_INACTIVE || realtimeRespectLedMaps);
+  unsigned run = 0, runEnd = 0, runIndex = 0; // compressed ledmap: next run, end of current run and physical index of next LED
+  int runStep = 0;
+  if (!_pixelCCT && !useLedmap) {
+    // fast path: frame buffer maps 1:1 to buses, hand over whole bus ranges (gamma is applied by the bus)
+    // buses that retain their content only receive the damaged range (ABL needs all pixels to estimate current)
+    if (BusManager::_useABL) BusManager::setPixelColors(_pixels, totalLen, useGammaCorrection);
+    else                     BusManager::setPixelColors(_pixels, totalLen, useGammaCorrection, dmgStart, dmgStop);
+  } else for (size_t i = 0; i < totalLen; i++) {
     // when correctWB is true setSegmentCCT() will convert CCT into K with which we can then
     // correct/adjust RGB value according to desired CCT value, it will still affect actual WW/CW ratio
     if (_pixelCCT) { // cctFromRgb already exluded at allocation
@@ -1771,7 +2106,20 @@ void WS2812FX::show() {
     uint32_t c = _pixels[i]; // need a copy, do not modify _pixels directly (no byte access allowed on ESP32)
     if (c > 0 && useGammaCorrection)
       c = gamma32(c); // apply gamma correction if enabled note: applying gamma after brightness has too much color loss
-    BusManager::setPixelColor(getMappedPixelIndex(i), c);
+    unsigned index = i;
+    if (useLedmap && i < customMappingSize) {
+      if (customMappingTable) index = customMappingTable[i];
+      else {
+        if (i == runEnd) { // runs are contiguous and visited in order, no search needed
+          runIndex = customMappingRuns[run].first;
+          runStep  = customMappingRuns[run].step;
+          runEnd   = ++run < customMappingRunCount ? customMappingRuns[run].start : customMappingSize;
+        }
+        index = uint16_t(runIndex);
+        runIndex += runStep;
+      }
+    }
+    BusManager::setPixelColor(index, c);
   }
   Bus::setCCT(oldCCT);  // restore old CCT for ABL adjustments
 
@@ -1782,6 +2130,11 @@ void WS2812FX::show() {
   // all of the data has been sent.
   // See https://github.com/Makuna/NeoPixelBus/wiki/ESP32-NeoMethods#neoesp32rmt-methods
   BusManager::show();
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  _showTime = (7 * _showTime + (micros() - showStart) + 4) >> 3; // moving average of time spent in show() (incl. blending & bus update)
+  if (unchanged) _framesSkipped++;
+  else           _framesShown++;
+  #endif
 
   if (diff > 0) { // skip calculation if no time has passed
     size_t fpsCurr = (1000 << FPS_CALC_SHIFT) / diff; // fixed point math
@@ -1799,6 +2152,26 @@ void WS2812FX::setRealtimePixelColor(unsigned i, uint32_t c) {
   }
 }
 
+// set count consecutive pixels starting at i from packed RGB or RGBW data (realtime protocols)
+// clipping and main segment/strip selection is done once per span instead of once per pixel
+void WS2812FX::setRealtimePixelColors(unsigned i, const uint8_t *data, unsigned count, unsigned channels) {
+  const bool hasWhite = channels > 3;
+  if (useMainSegmentOnly) {
+    const Segment &seg = getMainSegment();
+    if (!seg.isActive() || i >= seg.length()) return;
+    count = std::min(count, seg.length() - i);
+    for (unsigned n = i; n < i + count; n++, data += channels)
+      seg.setPixelColorRaw(n, RGBW32(data[0], data[1], data[2], hasWhite ? data[3] : 0));
+  } else {
+    unsigned totalLen = getLengthTotal();
+    if (!_pixels || i >= totalLen) return;
+    count = std::min(count, totalLen - i);
+    uint32_t *dst = _pixels + i;
+    if (hasWhite) for (unsigned n = 0; n < count; n++, data += channels) dst[n] = RGBW32(data[0], data[1], data[2], data[3]);
+    else          for (unsigned n = 0; n < count; n++, data += channels) dst[n] = RGBW32(data[0], data[1], data[2], 0);
+  }
+}
+
 // reset all segments
 void WS2812FX::restartRuntime() {
   suspend();
@@ -1823,7 +2196,8 @@ void WS2812FX::setTransitionMode(bool t) {
 void WS2812FX::waitForIt() {
   unsigned long waitStart = millis();
   unsigned long maxWait = 2*getFrameTime() + 100; // TODO: this needs a proper fix for timeout! see #4779
-  while (isServicing() && (millis() - waitStart < maxWait)) delay(1); // safe even when millis() rolls over
+  std::atomic_thread_fence(std::memory_order_seq_cst); // make _suspend visible to beginStateRead() before checking readers
+  while ((isServicing() || _stateReaders) && (millis() - waitStart < maxWait)) delay(1); // safe even when millis() rolls over
   #ifdef WLED_DEBUG
   if (millis()-waitStart >= maxWait) DEBUG_PRINTLN(F("Waited for strip to finish servicing."));
   #endif
@@ -1853,6 +2227,7 @@ void WS2812FX::setBrightness(uint8_t b, bool direct) {
     for (const Segment &seg : _segments) seg.freeze = false; // freeze is mutable
   }
   BusManager::setBrightness(scaledBri(b));
+  _forceFullFrame = true;
   if (!direct) {
     unsigned long t = millis();
     if (t - _lastShow > min(_frametime, uint16_t(FRAMETIME_FIXED))) trigger(); //apply brightness change immediately if no refresh soon, but don't speed up above 42fps
@@ -2096,29 +2471,215 @@ void WS2812FX::printSize() {
   size_t size = 0;
   for (const Segment &seg : _segments) size += seg.getSize();
   DEBUG_PRINTF_P(PSTR("Segments: %d -> %u/%dB\n"), _segments.size(), size, Segment::getUsedSegmentData());
+  #ifndef WLED_DISABLE_SEGMENT_ARENA
+  DEBUG_PRINTF_P(PSTR("Arena: %u/%uB in %u blocks, largest free %uB\n"), SegmentArena::getUsed(), SegmentArena::getSize(), SegmentArena::getBlocks(), SegmentArena::getLargestFree());
+  #endif
   for (const Segment &seg : _segments) DEBUG_PRINTF_P(PSTR("  Seg: %d,%d [A=%d, 2D=%d, RGB=%d, W=%d, CCT=%d]\n"), seg.width(), seg.height(), seg.isActive(), seg.is2D(), seg.hasRGB(), seg.hasWhite(), seg.isCCT());
   DEBUG_PRINTF_P(PSTR("Modes: %d*%d=%uB\n"), sizeof(mode_ptr), _mode.size(), (_mode.capacity()*sizeof(mode_ptr)));
   DEBUG_PRINTF_P(PSTR("Data: %d*%d=%uB\n"), sizeof(const char *), _modeData.size(), (_modeData.capacity()*sizeof(const char *)));
-  DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  if (customMappingTable) DEBUG_PRINTF_P(PSTR("Map: %d*%d=%uB\n"), sizeof(uint16_t), (int)customMappingSize, customMappingSize*sizeof(uint16_t));
+  else                    DEBUG_PRINTF_P(PSTR("Map: %d runs*%d=%uB (%d LEDs)\n"), (int)customMappingRunCount, sizeof(map_run_t), customMappingRunCount*sizeof(map_run_t), (int)customMappingSize);
+}
+#endif
+
+#ifdef WLED_ENABLE_FX_BENCHMARK
+// renders a number of frames of a single effect into a scratch segment (width x height) and measures effect execution time
+// scratch segment is never blended into _pixels[] so LED output is not affected (strip will just skip a few frames)
+// effect time (strip.now) advances by one frame time per frame so results do not depend on wall clock or current FPS
+// WARNING: must be called from loop() context (same as service()), never from async web server or UDP callbacks
+bool WS2812FX::benchmarkEffect(uint8_t mode, unsigned width, unsigned height, unsigned frames, fx_bench_t &res, uint8_t m12) {
+  res = {0, 0, 0, 0};
+  if (mode >= _modeCount || frames == 0 || _isServicing) return false;
+  if (strncmp_P("RSVD", getModeData(mode), 4) == 0) return false; // reserved/removed effect
+
+  Segment seg(0, width, 0, height);
+  if (!seg.isActive()) return false; // not enough RAM for pixel buffer
+  const Segment &mainSeg = getMainSegment();
+  for (unsigned i = 0; i < NUM_COLORS; i++) seg.colors[i] = mainSeg.colors[i];
+  bool stateChangedBefore = stateChanged;
+  uint16_t transitionBefore = _transitionDur;
+  _transitionDur = 0;     // setMode() must not create a transition copy of scratch segment
+  seg.setMode(mode, true); // load effect defaults (sliders, options & palette)
+  if (m12 <= M12_sPinwheel) seg.map1D2D = m12; // override 1D effect expansion on 2D segment
+  _transitionDur = transitionBefore;
+  stateChanged = stateChangedBefore;
+
+  Segment *currentBefore = _currentSegment;
+  unsigned long nowBefore = now;
+  unsigned frameTime = _frametime ? _frametime : FRAMETIME_FIXED;
+  uint32_t totalUs = 0;
+  _isServicing = true;
+  for (unsigned f = 0; f < frames; f++) {
+    now += frameTime;
+    seg.resetIfRequired();
+    seg.beginDraw();
+    _currentSegment = &seg;
+    uint32_t t0 = micros();
+    _mode[mode]();
+    uint32_t t = micros() - t0;
+    seg.call++;
+    totalUs += t;
+    if (t > res.maxUs) res.maxUs = t;
+    if (seg.dataSize() > res.dataLen) res.dataLen = seg.dataSize();
+    if (Segment::getUsedSegmentData() > res.dataUsed) res.dataUsed = Segment::getUsedSegmentData();
+    yield(); // keep wifi alive
+  }
+  _isServicing = false;
+  _currentSegment = currentBefore;
+  now = nowBefore;
+  res.avgUs = totalUs / frames;
+  DEBUGFX_PRINTF_P(PSTR("FX %u: %uus avg, %uus max, %uB data\n"), (unsigned)mode, res.avgUs, res.maxUs, (unsigned)res.dataLen);
+  return true;
 }
 #endif
 
+void WS2812FX::resetLedmap() {
+  d_free(customMappingTable);
+  d_free(customMappingRuns);
+  customMappingTable = nullptr;
+  customMappingRuns = nullptr;
+  customMappingSize = 0;
+  customMappingRunCount = 0;
+}
+
+// length of run of consecutive physical indexes (ascending, descending, unmapped or repeated) starting at i
+static unsigned ledmapRunLength(const uint16_t *map, unsigned i, unsigned size, int &step) {
+  step = 0;
+  if (i + 1 < size) {
+    int d = int(map[i+1]) - int(map[i]);
+    if (map[i] == 0xFFFFU || map[i+1] == 0xFFFFU) d = (map[i] == map[i+1]) ? 0 : 2; // unmapped LEDs only continue an unmapped run
+    if (d < -1 || d > 1) return 1;
+    step = d;
+  }
+  unsigned j = i + 1;
+  while (j < size && int(map[j]) - int(map[j-1]) == step && (step == 0 || map[j] != 0xFFFFU)) j++;
+  return j - i;
+}
+
+// most ledmaps (serpentine panels, reversed or identity strips) consist of a few runs of consecutive physical indexes
+// replace flat table (2 bytes per LED) with runs (6 bytes per run) if that at least halves memory use
+// trade-off: 64x64 serpentine needs 384B instead of 8kB, show() is ~10% slower (native build), lookups by index use a binary search
+void WS2812FX::compressLedmap() {
+  if (!customMappingTable || customMappingSize < 2) return;
+  int step;
+  unsigned runs = 0;
+  for (unsigned i = 0; i < customMappingSize; i += ledmapRunLength(customMappingTable, i, customMappingSize, step)) runs++;
+  if (runs * sizeof(map_run_t) * 2 > customMappingSize * sizeof(uint16_t)) {
+    DEBUG_PRINTF_P(PSTR("Ledmap not compressed: %u runs.\n"), runs);
+    return; // irregular map, keep flat table
+  }
+  customMappingRuns = static_cast<map_run_t*>(d_malloc(runs * sizeof(map_run_t)));
+  if (!customMappingRuns) return;
+  unsigned r = 0;
+  for (unsigned i = 0; i < customMappingSize; r++) {
+    unsigned len = ledmapRunLength(customMappingTable, i, customMappingSize, step);
+    customMappingRuns[r] = {uint16_t(i), customMappingTable[i], int16_t(step)};
+    i += len;
+  }
+  customMappingRunCount = runs;
+  DEBUG_PRINTF_P(PSTR("Ledmap compressed: %u LEDs in %u runs (%uB instead of %uB).\n"), customMappingSize, runs, runs * sizeof(map_run_t), customMappingSize * sizeof(uint16_t));
+  d_free(customMappingTable);
+  customMappingTable = nullptr;
+}
+
+// physical index of LED in compressed ledmap (index < customMappingSize)
+uint16_t WS2812FX::getRunMappedIndex(uint16_t index) const {
+  unsigned lo = 0, hi = customMappingRunCount; // find last run starting at or before index
+  while (hi - lo > 1) {
+    unsigned mid = (lo + hi) / 2;
+    if (customMappingRuns[mid].start <= index) lo = mid;
+    else hi = mid;
+  }
+  const map_run_t &r = customMappingRuns[lo];
+  return r.first + r.step * int(index - r.start);
+}
+
+// binary ledmap "ledmapN.bin": header followed by count little endian uint16 LED indexes (0xFFFF = unused)
+// generated from ledmapN.json when it is first loaded (removed when ledmapN.json is uploaded) or uploaded directly
+#define LEDMAP_BIN_VERSION 1
+typedef struct {
+  char     magic[3];  // "WLM"
+  uint8_t  version;
+  uint16_t width;     // 0 if not a 2D map
+  uint16_t height;
+  uint32_t count;     // number of indexes
+  uint32_t jsonSize;  // size of ledmapN.json it was generated from (0 = uploaded as binary)
+} ledmap_bin_t;
+static_assert(sizeof(ledmap_bin_t) == 16, "ledmap_bin_t must not be padded");
+
+// reads binary ledmap with a single block read, jsonSize is size of ledmapN.json (binary map is stale if it does not match)
+bool WS2812FX::loadBinaryMap(const char *fileName, unsigned n, size_t jsonSize) {
+  File f = WLED_FS.open(fileName, "r");
+  if (!f) return false;
+  ledmap_bin_t hdr;
+  bool valid = f.read(reinterpret_cast<uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+            && strncmp_P(hdr.magic, PSTR("WLM"), 3) == 0 && hdr.version == LEDMAP_BIN_VERSION
+            && f.size() == sizeof(hdr) + hdr.count * sizeof(uint16_t)
+            && (hdr.jsonSize == 0 || hdr.jsonSize == jsonSize);
+  if (!valid || hdr.count == 0) {
+    DEBUG_PRINTF_P(PSTR("Ignoring binary ledmap %s\n"), fileName);
+    f.close();
+    return false;
+  }
+  DEBUG_PRINTF_P(PSTR("Reading LED map from %s\n"), fileName);
+  // if we are loading default ledmap (at boot) set matrix width and height from the ledmap
+  if (n == 0 && hdr.width && hdr.height) {
+    Segment::maxWidth  = min(max((int)hdr.width, 1), 255);
+    Segment::maxHeight = min(max((int)hdr.height, 1), 255);
+    isMatrix = true;
+    DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
+  }
+
+  resetLedmap();
+  customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
+  if (customMappingTable) {
+    size_t count = min((size_t)hdr.count, (size_t)getLengthTotal());
+    customMappingSize = f.read(reinterpret_cast<uint8_t*>(customMappingTable), count * sizeof(uint16_t)) / sizeof(uint16_t);
+    currentLedmap = n;
+    compressLedmap();
+  } else {
+    DEBUG_PRINTLN(F("ERROR LED map allocation error."));
+  }
+  f.close();
+  return customMappingSize > 0;
+}
+
+// caches ledmap loaded from JSON so next load (i.e. at boot) does not need to parse it
+void WS2812FX::saveBinaryMap(const char *fileName, size_t jsonSize, unsigned width, unsigned height) const {
+  File f = WLED_FS.open(fileName, "w");
+  if (!f) return;
+  ledmap_bin_t hdr = {{'W','L','M'}, LEDMAP_BIN_VERSION, uint16_t(width), uint16_t(height), customMappingSize, uint32_t(jsonSize)};
+  size_t len = customMappingSize * sizeof(uint16_t);
+  bool ok = f.write(reinterpret_cast<const uint8_t*>(&hdr), sizeof(hdr)) == sizeof(hdr)
+         && f.write(reinterpret_cast<const uint8_t*>(customMappingTable), len) == len;
+  f.close();
+  if (!ok) WLED_FS.remove(fileName); // i.e. file system full
+  DEBUG_PRINTF_P(PSTR("Binary ledmap %s %s\n"), fileName, ok ? "saved" : "failed");
+  updateFSInfo();
+}
+
 // load custom mapping table from JSON file (called from finalizeInit() or deserializeState())
 // if this is a matrix set-up and default ledmap.json file does not exist, create mapping table using setUpMatrix() from panel information
+// binary ledmapN.bin is preferred if it exists and is not stale, otherwise it is created from ledmapN.json
 // WARNING: effect drawing has to be suspended (strip.suspend()) or must be called from loop() context
 bool WS2812FX::deserializeMap(unsigned n) {
   char fileName[32];
   strcpy_P(fileName, PSTR("/ledmap"));
   if (n) sprintf(fileName +7, "%d", n);
+  char binName[32];
+  strcpy(binName, fileName);
   strcat_P(fileName, PSTR(".json"));
+  strcat_P(binName, PSTR(".bin"));
   bool isFile = WLED_FS.exists(fileName);
+  bool isBin  = WLED_FS.exists(binName);
 
   customMappingSize = 0; // prevent use of mapping if anything goes wrong
+  _forceFullFrame = true;
   currentLedmap = 0;
-  if (n == 0 || isFile) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
+  if (n == 0 || isFile || isBin) interfaceUpdateCallMode = CALL_MODE_WS_SEND; // schedule WS update (to inform UI)
   uint32_t lengthTotalBefore = strip.getLengthTotal();
 
-  if (!isFile && n==0 && isMatrix) {
+  if (!isFile && !isBin && n==0 && isMatrix) {
     // 2D panel support creates its own ledmap (on the fly) if a ledmap.json does not exist
     setUpMatrix();
     if (strip.getLengthTotal() != lengthTotalBefore)
@@ -2126,6 +2687,18 @@ bool WS2812FX::deserializeMap(unsigned n) {
     return false;
   }
 
+  size_t jsonSize = 0;
+  if (isFile) {
+    File f = WLED_FS.open(fileName, "r");
+    jsonSize = f.size();
+    f.close();
+  }
+  if (isBin && loadBinaryMap(binName, n, jsonSize)) {
+    if (strip.getLengthTotal() != lengthTotalBefore)
+      strip.updatePixelBuffer(); // allocate _pixels[] to match new length
+    return true;
+  }
+
   if (!isFile || !requestJSONBufferLock(JSON_LOCK_LEDMAP)) return false;
 
   StaticJsonDocument<64> filter;
@@ -2147,11 +2720,12 @@ bool WS2812FX::deserializeMap(unsigned n) {
     DEBUG_PRINTF_P(PSTR("LED map width=%d, height=%d\n"), Segment::maxWidth, Segment::maxHeight);
   }
 
-  d_free(customMappingTable);
+  resetLedmap();
   customMappingTable = static_cast<uint16_t*>(d_malloc(sizeof(uint16_t)*getLengthTotal())); // prefer DRAM for speed
 
   if (customMappingTable) {
     DEBUG_PRINTF_P(PSTR("ledmap allocated: %uB\n"), sizeof(uint16_t)*getLengthTotal());
+    bool truncated = false; // map is longer than strip, do not cache it
     File f = WLED_FS.open(fileName, "r");
     f.find("\"map\":[");
     while (f.available()) { // f.position() < f.size() - 1
@@ -2171,11 +2745,12 @@ bool WS2812FX::deserializeMap(unsigned n) {
         if (index < 0 || index > 65535) index = 0xFFFF; // prevent integer wrap around
         customMappingTable[customMappingSize++] = index;
         if (end != nullptr) break; // array closing ']' was in this chunk; stop before atoi() coerces trailing JSON keys into bogus entries
-        if (customMappingSize >= getLengthTotal()) break;
+        if (customMappingSize >= getLengthTotal()) { truncated = f.available(); break; } // entries after this one (closing "]" is handled above)
       } else break; // there was nothing to read, stop
     }
     currentLedmap = n;
     f.close();
+    if (customMappingSize && !truncated) saveBinaryMap(binName, jsonSize, root[F("width")] | 0, root[F("height")] | 0);
 
     #ifdef WLED_DEBUG
     DEBUG_PRINT(F("Loaded ledmap:"));
@@ -2185,6 +2760,7 @@ bool WS2812FX::deserializeMap(unsigned n) {
     }
     DEBUG_PRINTLN();
     #endif
+    compressLedmap();
 /*
     JsonArray map = root[F("map")];
     if (!map.isNull() && map.size()) {  // not an empty map
@@ -18,6 +18,7 @@
 static int32_t calcForce_dv(const int8_t force, uint8_t &counter);
 static bool checkBoundsAndWrap(int32_t &position, const int32_t max, const int32_t particleradius, const bool wrap); // returns false if out of bounds by more than particleradius
 static uint32_t fast_color_scaleAdd(const uint32_t c1, const uint32_t c2, uint8_t scale = 255); // fast and accurate color adding with scaling (scales c2 before adding)
+static uint32_t gridCellShift(uint32_t cellsize); // returns shift for smallest power of 2 >= cellsize
 #endif
 
 #ifndef WLED_DISABLE_PARTICLESYSTEM2D
@@ -29,7 +30,7 @@ ParticleSystem2D::ParticleSystem2D(uint32_t width, uint32_t height, uint32_t num
   advPartProps = nullptr; //make sure we start out with null pointers (just in case memory was not cleared)
   advPartSize = nullptr;
   setMatrixSize(width, height);
-  updatePSpointers(isadvanced, sizecontrol); // set the particle and sources pointer (call this before accessing sprays or particles)
+  updatePSpointers(isadvanced, sizecontrol, particleCollisionGrid); // set the particle and sources pointer (call this before accessing sprays or particles)
   setWallHardness(255); // set default wall hardness to max
   setWallRoughness(0); // smooth walls by default
   setGravity(0); //gravity disabled by default
@@ -440,15 +441,18 @@ void ParticleSystem2D::applyForce(const uint32_t particleindex, const int8_t xfo
 
 // apply a force in x,y direction to all particles
 // force is in 3.4 fixed point notation (see above)
+// note: all particles share the same counter so dv is the same for all of them, calculate it once and keep the loop free of branches
 void ParticleSystem2D::applyForce(const int8_t xforce, const int8_t yforce) {
-  // for small forces, need to use a delay counter
-  uint8_t tempcounter;
-  // note: this is not the most computationally efficient way to do this, but it saves on duplicate code and is fast enough
+  uint8_t xcounter = forcecounter & 0x0F; // lower four bits
+  uint8_t ycounter = forcecounter >> 4;   // upper four bits
+  int32_t dvx = calcForce_dv(xforce, xcounter);
+  int32_t dvy = calcForce_dv(yforce, ycounter);
+  forcecounter = (xcounter & 0x0F) | ((ycounter << 4) & 0xF0); // save counter values back
+  if (dvx == 0 && dvy == 0) return;
   for (uint32_t i = 0; i < usedParticles; i++) {
-    tempcounter = forcecounter;
-    applyForce(particles[i], xforce, yforce, tempcounter);
+    particles[i].vx = limitSpeed((int32_t)particles[i].vx + dvx);
+    particles[i].vy = limitSpeed((int32_t)particles[i].vy + dvy);
   }
-  forcecounter = tempcounter; // save value back
 }
 
 // apply a force in angular direction to single particle
@@ -575,12 +579,9 @@ void ParticleSystem2D::render() {
   }
 
   if (motionBlur) { // motion-blurring active
-    for (int32_t y = 0; y <= maxYpixel; y++) {
-      int index = y * (maxXpixel + 1);
-      for (int32_t x = 0; x <= maxXpixel; x++) {
-        framebuffer[index] = fast_color_scale(framebuffer[index], motionBlur); // note: could skip if only globalsmear is active but usually they are both active and scaling is fast enough
-        index++;
-      }
+    const uint32_t bufsize = (maxXpixel + 1) * (maxYpixel + 1); // framebuffer is contiguous, a flat loop is cheaper than x/y loops
+    for (uint32_t i = 0; i < bufsize; i++) {
+      framebuffer[i] = fast_color_scale(framebuffer[i], motionBlur); // note: could skip if only globalsmear is active but usually they are both active and scaling is fast enough
     }
   }
   else { // no blurring: clear buffer
@@ -816,6 +817,10 @@ void WLED_O2_ATTR ParticleSystem2D::renderLargeParticle(const uint32_t size, con
 // for code simplicity, no y slicing is done, making very tall matrix configurations less efficient
 // note: also tested adding y slicing, it gives diminishing returns, some FX even get slower. FX not using gravity would benefit with a 10% FPS improvement
 void ParticleSystem2D::handleCollisions() {
+  if (collisionGrid) { // grid space is reserved if grid collisions were enabled when the system was created
+    handleCollisionsGrid();
+    return;
+  }
   uint32_t collDistSq = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
   collDistSq = collDistSq * collDistSq; // square it for faster comparison (square is one operation)
   // note: partices are binned in x-axis, assumption is that no more than half of the particles are in the same bin
@@ -859,37 +864,91 @@ void ParticleSystem2D::handleCollisions() {
       if (pidx >= usedParticles) pidx = 0; // wrap around
     }
 
-    int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
-    int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
     for (uint32_t i = 0; i < binParticleCount; i++) { // go though all 'higher number' particles in this bin and see if any of those are in close proximity and if they are, make them collide
       uint32_t idx_i = binIndices[i];
       for (uint32_t j = i + 1; j < binParticleCount; j++) { // check against higher number particles
-        uint32_t idx_j = binIndices[j];
-        if (perParticleSize && advPartProps != nullptr) { // using individual particle size
-          collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
-          collDistSq = collDistSq * collDistSq; // square it for faster comparison
-          // calculate mass ratio for collision response
-          uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
-          uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
-          mass1 = mass1 * mass1; // mass proportional to area
-          mass2 = mass2 * mass2;
-          uint32_t totalmass = mass1 + mass2;
-          massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
-          massratio2 = (mass1 << 8) / totalmass;
-        }
-        // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
-        int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
-        if (dx * dx < collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
-          int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
-          if (dy * dy < collDistSq) // particles are close
-            collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
-        }
+        checkCollision(idx_i, binIndices[j], collDistSq);
       }
     }
   }
   collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
 
+// detect collisions using a spatial grid: particles are sorted into square cells at least as large as the collision distance (using look-ahead position)
+// so only particles in the same or in adjacent cells need to be checked. unlike binning, all particles are handled every frame
+// cell lists are stored in collisionGrid (linked through particle indices), cell size is increased if the matrix would need more than PS_GRID_CELLS() cells
+void ParticleSystem2D::handleCollisionsGrid() {
+  uint32_t collDist = particleHardRadius << 1; // distance is double the radius note: particleHardRadius is updated when setting global particle size
+  uint32_t maxCollDist = collDist;
+  if (perParticleSize && advPartProps != nullptr)
+    maxCollDist = (PS_P_MINHARDRADIUS << 1) + ((2 * 255 * 52) >> 6); // largest possible collision distance of two particles
+  uint32_t cellShift = gridCellShift(maxCollDist);
+  uint32_t cols, rows;
+  do {
+    cols = (maxX >> cellShift) + 1;
+    rows = (maxY >> cellShift) + 1;
+  } while (cols * rows > PS_GRID_CELLS(numParticles) && ++cellShift);
+  uint16_t *cellHead = collisionGrid;
+  uint16_t *nextInCell = collisionGrid + PS_GRID_CELLS(numParticles);
+  memset(cellHead, 0xFF, cols * rows * sizeof(uint16_t)); // 0xFFFF marks end of list
+
+  // sort particles into cells
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds || !particleFlags[i].collide) continue;
+    int32_t x = constrain(particles[i].x + particles[i].vx, 0, maxX); // look-ahead position (same as used for distance), edge cells collect out of bounds positions
+    int32_t y = constrain(particles[i].y + particles[i].vy, 0, maxY);
+    uint32_t cell = (y >> cellShift) * cols + (x >> cellShift);
+    nextInCell[i] = cellHead[cell];
+    cellHead[cell] = i;
+  }
+
+  // check each cell against itself and the 4 'forward' neighbours so each pair of cells is visited once
+  const uint32_t collDistSq = collDist * collDist;
+  for (uint32_t cy = 0; cy < rows; cy++) {
+    for (uint32_t cx = 0; cx < cols; cx++) {
+      uint32_t cell = cy * cols + cx;
+      for (uint32_t i = cellHead[cell]; i != 0xFFFF; i = nextInCell[i]) {
+        for (uint32_t j = nextInCell[i]; j != 0xFFFF; j = nextInCell[j]) checkCollision(i, j, collDistSq);
+        if (cx + 1 < cols)
+          for (uint32_t j = cellHead[cell + 1]; j != 0xFFFF; j = nextInCell[j]) checkCollision(i, j, collDistSq);
+        if (cy + 1 < rows) {
+          uint32_t below = cell + cols;
+          if (cx > 0)
+            for (uint32_t j = cellHead[below - 1]; j != 0xFFFF; j = nextInCell[j]) checkCollision(i, j, collDistSq);
+          for (uint32_t j = cellHead[below]; j != 0xFFFF; j = nextInCell[j]) checkCollision(i, j, collDistSq);
+          if (cx + 1 < cols)
+            for (uint32_t j = cellHead[below + 1]; j != 0xFFFF; j = nextInCell[j]) checkCollision(i, j, collDistSq);
+        }
+      }
+    }
+  }
+}
+
+// check two particles for imminent collision (using look-ahead) and handle it
+void WLED_O2_ATTR ParticleSystem2D::checkCollision(const uint32_t idx_i, const uint32_t idx_j, uint32_t collDistSq) {
+  int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
+  int32_t massratio2 = 0; // TODO: if implementing "fixed" particles, set to 1 (fixed) and 255 (movable)
+  if (perParticleSize && advPartProps != nullptr) { // using individual particle size
+    collDistSq = (PS_P_MINHARDRADIUS << 1) + ((((uint32_t)advPartProps[idx_i].size + (uint32_t)advPartProps[idx_j].size) * 52) >> 6); // collision distance, use 80% of size for tighter stacking (slight overlap)
+    collDistSq = collDistSq * collDistSq; // square it for faster comparison
+    // calculate mass ratio for collision response
+    uint32_t mass1 = PS_P_RADIUS + advPartProps[idx_i].size;
+    uint32_t mass2 = PS_P_RADIUS + advPartProps[idx_j].size;
+    mass1 = mass1 * mass1; // mass proportional to area
+    mass2 = mass2 * mass2;
+    uint32_t totalmass = mass1 + mass2;
+    massratio1 = (mass2 << 8) / totalmass; // massratio 1 depends on mass of particle 2, i.e. if 2 is heavier -> higher velocity impact on 1
+    massratio2 = (mass1 << 8) / totalmass;
+  }
+  // note: using the same logic as in 1D is much slower though it would be more accurate but it is not really needed in 2D: particles slipping through each other is much less visible
+  int32_t dx = (particles[idx_j].x + particles[idx_j].vx) - (particles[idx_i].x + particles[idx_i].vx); // distance with lookahead
+  if (dx * dx < (int32_t)collDistSq) { // check x direction, if close, check y direction (squaring is faster than abs() or dual compare)
+    int32_t dy = (particles[idx_j].y + particles[idx_j].vy)  - (particles[idx_i].y + particles[idx_i].vy); // distance with lookahead
+    if (dy * dy < (int32_t)collDistSq) // particles are close
+      collideParticles(particles[idx_i], particles[idx_j], dx, dy, collDistSq, massratio1, massratio2);
+  }
+}
+
 // handle a collision if close proximity is detected, i.e. dx and/or dy smaller than 2*PS_P_RADIUS
 // takes two pointers to the particles to collide and the particle hardness (softer means more energy lost in collision, 255 means full hard)
 void WLED_O2_ATTR ParticleSystem2D::collideParticles(PSparticle &particle1, PSparticle &particle2, int32_t dx, int32_t dy, const uint32_t collDistSq, int32_t massratio1, int32_t massratio2) {
@@ -1015,14 +1074,14 @@ void WLED_O2_ATTR ParticleSystem2D::collideParticles(PSparticle &particle1, PSpa
 void ParticleSystem2D::updateSystem(void) {
   //PSPRINTLN("updateSystem2D");
   setMatrixSize(SEGMENT.vWidth(), SEGMENT.vHeight());
-  updatePSpointers(advPartProps != nullptr, advPartSize != nullptr); // update pointers to PS data, also updates availableParticles
+  updatePSpointers(advPartProps != nullptr, advPartSize != nullptr, collisionGrid != nullptr); // update pointers to PS data, also updates availableParticles
   //PSPRINTLN("\n END update System2D, running FX...");
 }
 
 // set the pointers for the class (this only has to be done once and not on every FX call, only the class pointer needs to be reassigned to SEGENV.data every time)
 // function returns the pointer to the next byte available for the FX (if it assigned more memory for other stuff using the above allocate function)
 // FX handles the PSsources, need to tell this function how many there are
-void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
+void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol, bool grid) {
   //PSPRINTLN("updatePSpointers");
   // Note on memory alignment:
   // a pointer MUST be 4 byte aligned. sizeof() in a struct/class is always aligned to the largest element. if it contains a 32bit, it will be padded to 4 bytes, 16bit is padded to 2byte alignment.
@@ -1041,6 +1100,11 @@ void ParticleSystem2D::updatePSpointers(bool isadvanced, bool sizecontrol) {
       PSdataEnd = reinterpret_cast<uint8_t *>(advPartSize + numParticles);
     }
   }
+  collisionGrid = nullptr;
+  if (grid) {
+    collisionGrid = reinterpret_cast<uint16_t *>(PSdataEnd);
+    PSdataEnd += PS_GRID_SIZE(numParticles); // multiple of 4 bytes
+  }
 #ifdef DEBUG_PS
   Serial.printf_P(PSTR(" particles %p "), particles);
   Serial.printf_P(PSTR(" sources %p "), sources);
@@ -1086,6 +1150,8 @@ bool allocateParticleSystemMemory2D(uint32_t numparticles, uint32_t numsources,
     requiredmemory += sizeof(PSadvancedParticle) * numparticles;
   if (sizecontrol)
     requiredmemory += sizeof(PSsizeControl) * numparticles;
+  if (particleCollisionGrid)
+    requiredmemory += PS_GRID_SIZE(numparticles);
   requiredmemory += sizeof(PSsource) * numsources;
   requiredmemory += additionalbytes;
   return(SEGMENT.allocateData(requiredmemory));
@@ -1145,7 +1211,7 @@ ParticleSystem1D::ParticleSystem1D(uint32_t length, uint32_t numberofparticles,
   advPartProps = nullptr; //make sure we start out with null pointers (just in case memory was not cleared)
   //advPartSize = nullptr;
   setSize(length);
-  updatePSpointers(isadvanced); // set the particle and sources pointer (call this before accessing sprays or particles)
+  updatePSpointers(isadvanced, particleCollisionGrid); // set the particle and sources pointer (call this before accessing sprays or particles)
   setWallHardness(255); // set default wall hardness to max
   setGravity(0); //gravity disabled by default
   setParticleSize(0); // 1 pixel size by default
@@ -1608,6 +1674,10 @@ void WLED_O2_ATTR ParticleSystem1D::renderLargeParticle(const uint32_t size, con
 
 // detect collisions in an array of particles and handle them
 void ParticleSystem1D::handleCollisions() {
+  if (collisionGrid) { // grid space is reserved if grid collisions were enabled when the system was created
+    handleCollisionsGrid();
+    return;
+  }
   uint32_t collisiondistance = particleHardRadius << 1; // twice the radius is min distance between colliding particles
   uint32_t checkDistSq = max(2 * PS_P_MAXSPEED, (int)collisiondistance);
   if (perParticleSize && advPartProps != nullptr) // using individual particle size
@@ -1665,6 +1735,46 @@ void ParticleSystem1D::handleCollisions() {
   }
   collisionStartIdx = nextFrameStartIdx; // set the start index for the next frame
 }
+
+// detect collisions using a grid of cells at least as large as the check distance, only particles in the same or next cell are checked (see 2D)
+void ParticleSystem1D::handleCollisionsGrid() {
+  uint32_t collisiondistance = particleHardRadius << 1; // twice the radius is min distance between colliding particles
+  uint32_t checkDist = max(2 * PS_P_MAXSPEED, (int)collisiondistance);
+  if (perParticleSize && advPartProps != nullptr) // using individual particle size
+    checkDist = max(2 * PS_P_MAXSPEED, (512 * 52) >> 6); // max possible collision distance that catches all collisons
+  const uint32_t checkDistSq = checkDist * checkDist;
+  uint32_t cellShift = gridCellShift(checkDist);
+  uint32_t cells;
+  do {
+    cells = (maxX >> cellShift) + 1;
+  } while (cells > PS_GRID_CELLS(numParticles) && ++cellShift);
+  uint16_t *cellHead = collisionGrid;
+  uint16_t *nextInCell = collisionGrid + PS_GRID_CELLS(numParticles);
+  memset(cellHead, 0xFF, cells * sizeof(uint16_t)); // 0xFFFF marks end of list
+
+  for (uint32_t i = 0; i < usedParticles; i++) {
+    if (particles[i].ttl == 0 || particleFlags[i].outofbounds || !particleFlags[i].collide) continue;
+    uint32_t cell = constrain(particles[i].x, 0, maxX) >> cellShift; // edge cells collect out of bounds positions
+    nextInCell[i] = cellHead[cell];
+    cellHead[cell] = i;
+  }
+
+  for (uint32_t cell = 0; cell < cells; cell++) {
+    for (uint32_t i = cellHead[cell]; i != 0xFFFF; i = nextInCell[i]) {
+      for (uint32_t j = nextInCell[i]; j != 0xFFFF; j = nextInCell[j]) {
+        int32_t dx = particles[j].x - particles[i].x;
+        if ((uint32_t)(dx * dx) <= checkDistSq) collideParticles(i, j, dx, collisiondistance);
+      }
+      if (cell + 1 < cells) {
+        for (uint32_t j = cellHead[cell + 1]; j != 0xFFFF; j = nextInCell[j]) {
+          int32_t dx = particles[j].x - particles[i].x;
+          if ((uint32_t)(dx * dx) <= checkDistSq) collideParticles(i, j, dx, collisiondistance);
+        }
+      }
+    }
+  }
+}
+
 // handle a collision if close proximity is detected, i.e. dx smaller than 2*radius + speed look-ahead
 void WLED_O2_ATTR ParticleSystem1D::collideParticles(uint32_t partIdx1, uint32_t partIdx2, int32_t dx, uint32_t collisiondistance) {
   int32_t massratio1 = 0; // 0 means dont use mass ratio (equal mass)
@@ -1761,13 +1871,13 @@ void WLED_O2_ATTR ParticleSystem1D::collideParticles(uint32_t partIdx1, uint32_t
 // note: do not access the PS class in FX befor running this function (or it messes up SEGENV.data)
 void ParticleSystem1D::updateSystem(void) {
   setSize(SEGMENT.vLength()); // update size
-  updatePSpointers(advPartProps != nullptr);
+  updatePSpointers(advPartProps != nullptr, collisionGrid != nullptr);
 }
 
 // set the pointers for the class (this only has to be done once and not on every FX call, only the class pointer needs to be reassigned to SEGENV.data every time)
 // function returns the pointer to the next byte available for the FX (if it assigned more memory for other stuff using the above allocate function)
 // FX handles the PSsources, need to tell this function how many there are
-void ParticleSystem1D::updatePSpointers(bool isadvanced) {
+void ParticleSystem1D::updatePSpointers(bool isadvanced, bool grid) {
   // Note on memory alignment:
   // a pointer MUST be 4 byte aligned. sizeof() in a struct/class is always aligned to the largest element. if it contains a 32bit, it will be padded to 4 bytes, 16bit is padded to 2byte alignment.
   // The PS is aligned to 4 bytes, a PSparticle is aligned to 2 and a struct containing only byte sized variables is not aligned at all and may need to be padded when dividing the memoryblock.
@@ -1789,6 +1899,11 @@ void ParticleSystem1D::updatePSpointers(bool isadvanced) {
     advPartProps = reinterpret_cast<PSadvancedParticle1D *>(PSdataEnd);
     PSdataEnd = reinterpret_cast<uint8_t *>(advPartProps + numParticles); // since numParticles is a multiple of 4, this is always aligned to 4 bytes. No need to add padding bytes here
   }
+  collisionGrid = nullptr;
+  if (grid) {
+    collisionGrid = reinterpret_cast<uint16_t *>(PSdataEnd);
+    PSdataEnd += PS_GRID_SIZE(numParticles); // multiple of 4 bytes
+  }
   #ifdef WLED_DEBUG_PS
   PSPRINTLN(" PS Pointers: ");
   PSPRINT(" PS : 0x");
@@ -1838,6 +1953,8 @@ bool allocateParticleSystemMemory1D(const uint32_t numparticles, const uint32_t
   requiredmemory += additionalbytes;
   if (isadvanced)
     requiredmemory += sizeof(PSadvancedParticle1D) * numparticles;
+  if (particleCollisionGrid)
+    requiredmemory += PS_GRID_SIZE(numparticles);
   return(SEGMENT.allocateData(requiredmemory));
 }
 
@@ -1876,6 +1993,13 @@ bool initParticleSystem1D(ParticleSystem1D *&PartSys, const uint32_t requestedso
 // Shared Utility Functions //
 //////////////////////////////
 
+// returns shift of smallest power of 2 cell size that is >= cellsize (collision grid)
+static uint32_t gridCellShift(uint32_t cellsize) {
+  uint32_t shift = 0;
+  while ((1U << shift) < cellsize) shift++;
+  return shift;
+}
+
 // calculate the delta speed (dV) value and update the counter for force calculation (is used several times, function saves on codesize)
 // force is in 3.4 fixedpoint notation, +/-127
 static int32_t calcForce_dv(const int8_t force, uint8_t &counter) {
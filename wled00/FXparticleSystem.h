@@ -21,6 +21,8 @@
 
 #define PS_P_MAXSPEED 120 // maximum speed a particle can have (vx/vy is int8), limiting below 127 to avoid overflows in collisions due to rounding errors
 #define MAX_MEMIDLE 10 // max idle time (in frames) before memory is deallocated (if deallocated during an effect, it will crash!)
+#define PS_GRID_CELLS(n) ((n) >> 1) // max. number of collision grid cells for n particles
+#define PS_GRID_SIZE(n) ((PS_GRID_CELLS(n) + (n)) * sizeof(uint16_t)) // collision grid memory: cell list heads and per particle list links (n is a multiple of 4, keeps alignment)
 
 //#define WLED_DEBUG_PS // note: enabling debug uses ~3k of flash
 
@@ -78,6 +80,8 @@ typedef union {
 } PSsettings2D;
 
 //struct for a single particle
+// note: particles are kept as array of structs, effects, sources and the per-particle API use PSparticle directly;
+// move, collide and render touch all of x/y/vx/vy/ttl of a particle at once so a split layout would not save memory traffic
 typedef struct { // 10 bytes
   int16_t x;  // x position in particle system
   int16_t y;  // y position in particle system
@@ -203,16 +207,19 @@ private:
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
   void handleCollisions();
+  void handleCollisionsGrid();
+  [[gnu::hot]] void checkCollision(const uint32_t idx_i, const uint32_t idx_j, uint32_t collDistSq);
   void collideParticles(PSparticle &particle1, PSparticle &particle2, int32_t dx, int32_t dy, const uint32_t collDistSq, int32_t massratio1, int32_t massratio2);
   void fireParticleupdate();
   //utility functions
-  void updatePSpointers(const bool isadvanced, const bool sizecontrol); // update the data pointers to current segment data space
+  void updatePSpointers(const bool isadvanced, const bool sizecontrol, const bool grid); // update the data pointers to current segment data space
   bool updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
   void getParticleXYsize(PSadvancedParticle *advprops, PSsizeControl *advsize, uint32_t &xsize, uint32_t &ysize);
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
   PSsettings2D particlesettings; // settings used when updating particles (can also used by FX to move sources), do not edit properties directly, use functions above
+  uint16_t *collisionGrid; // collision grid in segment data (nullptr: binning): PS_GRID_CELLS() cell list heads followed by numParticles list links
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
   int32_t collisionHardness;
@@ -390,15 +397,17 @@ private:
   //paricle physics applied by system if flags are set
   void applyGravity(); // applies gravity to all particles
   void handleCollisions();
+  void handleCollisionsGrid();
   void collideParticles(uint32_t partIdx1, uint32_t partIdx2, int32_t dx, uint32_t collisiondistance);
 
   //utility functions
-  void updatePSpointers(const bool isadvanced); // update the data pointers to current segment data space
+  void updatePSpointers(const bool isadvanced, const bool grid); // update the data pointers to current segment data space
   //void updateSize(PSadvancedParticle *advprops, PSsizeControl *advsize); // advanced size control
   [[gnu::hot]] void bounce(int8_t &incomingspeed, int8_t &parallelspeed, int32_t &position, const uint32_t maxposition); // bounce on a wall
   // note: variables that are accessed often are 32bit for speed
   uint32_t *framebuffer; // frame buffer for rendering. note: using CRGBW as the buffer is slower, ESP compiler seems to optimize this better giving more consistent FPS
   PSsettings1D particlesettings; // settings used when updating particles
+  uint16_t *collisionGrid; // collision grid in segment data (nullptr: binning): PS_GRID_CELLS() cell list heads followed by numParticles list links
   uint32_t numParticles;  // total number of particles allocated by this system
   uint32_t emitIndex; // index to count through particles to emit so searching for dead pixels is faster
   int32_t collisionHardness;
@@ -125,6 +125,13 @@ uint32_t Bus::autoWhiteCalc(uint32_t c, uint8_t &ww, uint8_t &cw) const {
   return c;
 }
 
+// generic bulk update, buses with per-pixel overhead (color order lookup etc.) should override it
+void Bus::setPixelColors(unsigned pix, const uint32_t *c, unsigned len, bool gamma) {
+  if (pix >= getLength()) return;
+  if (pix + len > getLength()) len = getLength() - pix;
+  for (unsigned i = 0; i < len; i++) setPixelColor(pix + i, (c[i] && gamma) ? gamma32(c[i]) : c[i]);
+}
+
 
 BusDigital::BusDigital(const BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count, bc.reversed, (bc.refreshReq || bc.type == TYPE_TM1814))
@@ -266,12 +273,11 @@ void BusDigital::setStatusPixel(uint32_t c) {
   }
 }
 
-// note: using WLED_O2_ATTR makes this function ~7% faster at the expense of 600 bytes of flash
-void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
-  if (!_valid) return;
+// color processing common to setPixelColor() and setPixelColors()
+inline uint32_t BusDigital::prepareColor(uint32_t c, uint16_t &wwcw) {
   if (Bus::_cct >= 1900) c = colorBalanceFromKelvin(Bus::_cct, c); //color correction from CCT
   uint8_t cctWW = 0, cctCW = 0;
-  uint16_t wwcw = 0;
+  wwcw = 0;
   if (hasWhite()) c = autoWhiteCalc(c, cctWW, cctCW);
   c = color_fade(c, _bri, true); // apply brightness
 
@@ -290,6 +296,14 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
       _colorSum += ((r > g) ? ((r > b) ? r : b) : ((g > b) ? g : b));
     }
   }
+  return c;
+}
+
+// note: using WLED_O2_ATTR makes this function ~7% faster at the expense of 600 bytes of flash
+void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
+  if (!_valid) return;
+  uint16_t wwcw;
+  c = prepareColor(c, wwcw);
 
   if (_reversed) pix = _len - pix -1;
   pix += _skip;
@@ -308,6 +322,45 @@ void IRAM_ATTR BusDigital::setPixelColor(unsigned pix, uint32_t c) {
   PolyBus::setPixelColor(_busPtr, _iType, pix, c, co, wwcw);
 }
 
+// bulk version of setPixelColor() used by strip.show(): walks precomputed color order runs instead of
+// looking up ColorOrderMap for each pixel, reverse & skip are resolved once per run
+void IRAM_ATTR BusDigital::setPixelColors(unsigned pix, const uint32_t *c, unsigned len, bool gamma) {
+  if (!_valid || pix >= _len) return;
+  if (_type == TYPE_WS2812_1CH_X3 || _colorOrderRuns.empty()) { Bus::setPixelColors(pix, c, len, gamma); return; } // X3 needs read-modify-write
+  if (pix + len > _len) len = _len - pix;
+  c -= pix; // index c[] with bus pixel
+  for (const auto &run : _colorOrderRuns) {
+    // run covers physical pixels [run.start, run.start+run.len), convert to logical (unskipped, unreversed) range
+    int first = int(run.start) - _skip;
+    int last  = first + run.len - 1;
+    if (last < 0) continue; // skipped pixels only
+    if (first < 0) first = 0;
+    if (_reversed) { int t = first; first = _len - 1 - last; last = _len - 1 - t; }
+    if (first < (int)pix) first = pix;
+    if (last >= int(pix + len)) last = pix + len - 1;
+    for (int i = first; i <= last; i++) {
+      uint32_t col = c[i];
+      if (col && gamma) col = gamma32(col);
+      uint16_t wwcw;
+      col = prepareColor(col, wwcw);
+      unsigned pix = (_reversed ? _len - i - 1 : i) + _skip;
+      PolyBus::setPixelColor(_busPtr, _iType, pix, col, run.colorOrder, wwcw);
+    }
+  }
+}
+
+// precompute color order for consecutive physical pixels, called when bus is started or color order changes
+void BusDigital::updateColorOrderRuns() {
+  _colorOrderRuns.clear();
+  unsigned hwLen = _len + _skip;
+  for (unsigned i = 0; i < hwLen; i++) {
+    uint8_t co = _colorOrderMap.getPixelColorOrder(i + _start, _colorOrder);
+    if (_colorOrderRuns.empty() || _colorOrderRuns.back().colorOrder != co) _colorOrderRuns.push_back({uint16_t(i), 0, co});
+    _colorOrderRuns.back().len++;
+  }
+  _colorOrderRuns.shrink_to_fit();
+}
+
 // returns lossly restored color from bus
 uint32_t IRAM_ATTR BusDigital::getPixelColor(unsigned pix) const {
   if (!_valid) return 0;
@@ -346,6 +399,7 @@ void BusDigital::setColorOrder(uint8_t colorOrder) {
   // upper nibble contains W swap information
   if ((colorOrder & 0x0F) > 5) return;
   _colorOrder = colorOrder;
+  if (_valid) updateColorOrderRuns();
 }
 
 // credit @willmmiles & @netmindz https://github.com/wled/WLED/pull/4056
@@ -380,6 +434,7 @@ bool BusDigital::isI2S() {
 void BusDigital::begin() {
   if (!_valid) return;
   PolyBus::begin(_busPtr, _iType, _pins, _frequencykHz);
+  updateColorOrderRuns();
 }
 
 void BusDigital::cleanup() {
@@ -701,8 +756,27 @@ std::vector<LEDType> BusOnOff::getLEDTypes() {
   };
 }
 
+uint32_t BusNetwork::_sendTime = 0;
+uint32_t BusNetwork::_framesSkipped = 0;
+
+#ifdef ARDUINO_ARCH_ESP32
+#ifndef WLED_NETBUS_TASK_PRIORITY
+  #define WLED_NETBUS_TASK_PRIORITY 2 // same as DMX receiver task
+#endif
+QueueHandle_t BusNetwork::_sendQueue = nullptr;
+
+// sends frames of network buses so that network latency does not stretch rendering or output of other buses
+void BusNetwork::sendTask(void *) {
+  BusNetwork *bus;
+  for (;;) {
+    if (xQueueReceive(_sendQueue, &bus, portMAX_DELAY) == pdTRUE) bus->send();
+  }
+}
+#endif
+
 BusNetwork::BusNetwork(const BusConfig &bc)
 : Bus(bc.type, bc.start, bc.autoWhite, bc.count)
+, _sendBri(255)
 , _broadcastLock(false)
 {
   switch (bc.type) {
@@ -724,12 +798,33 @@ BusNetwork::BusNetwork(const BusConfig &bc)
   _hasCCT = false;
   _UDPchannels = _hasWhite + 3;
   _client = IPAddress(bc.pins[0],bc.pins[1],bc.pins[2],bc.pins[3]);
+  _universe = constrain(bc.universe, 1, 63999);
+  _priority = min(bc.priority, (uint8_t)200);
+  _syncUniverse = min(bc.syncUniverse, (uint16_t)63999);
   #ifdef ARDUINO_ARCH_ESP32
   _hostname = bc.text;
   resolveHostname(); // resolve hostname to IP address if needed
   #endif
   _data = (uint8_t*)d_calloc(_len, _UDPchannels);
-  _valid = (_data != nullptr);
+  _sendData = _data;
+  _packetSize = realtimeBroadcastBufferSize(_UDPtype, _len * _UDPchannels);
+  _packet = _packetSize ? (uint8_t*)d_malloc(_packetSize) : nullptr;
+  _valid = (_data != nullptr && (_packet != nullptr || !_packetSize));
+  #ifdef ARDUINO_ARCH_ESP32
+  // sender task is shared by all network buses and is never deleted
+  if (!_sendQueue) {
+    _sendQueue = xQueueCreate(WLED_MAX_BUSSES, sizeof(BusNetwork*));
+    if (_sendQueue && xTaskCreatePinnedToCore(sendTask, "NetBus", 4096, nullptr, WLED_NETBUS_TASK_PRIORITY, nullptr, 0) != pdPASS) {
+      vQueueDelete(_sendQueue);
+      _sendQueue = nullptr;
+    }
+    if (!_sendQueue) DEBUGBUS_PRINTLN(F("Network bus sender task could not be created, sending synchronously."));
+  }
+  if (_valid && _sendQueue) {
+    _sendData = (uint8_t*)d_malloc(_len * _UDPchannels);
+    _valid = (_sendData != nullptr);
+  }
+  #endif
   DEBUGBUS_PRINTF_P(PSTR("%successfully inited virtual strip with type %u and IP %u.%u.%u.%u\n"), _valid?"S":"Uns", bc.type, bc.pins[0], bc.pins[1], bc.pins[2], bc.pins[3]);
 }
 
@@ -751,11 +846,34 @@ uint32_t BusNetwork::getPixelColor(unsigned pix) const {
   return RGBW32(_data[offset], _data[offset+1], _data[offset+2], (hasWhite() ? _data[offset+3] : 0));
 }
 
+void BusNetwork::send() {
+  unsigned long start = micros();
+  realtimeBroadcast(_UDPtype, _client, _len, _sendData, _packet, _sendBri, hasWhite(), _universe, _priority, _syncUniverse);
+  _sendTime = (7 * _sendTime + (micros() - start) + 4) / 8; // moving average
+  _broadcastLock = false;
+}
+
+// note: _data is copied (not swapped) into the send buffer as it needs to retain content for partial updates
 void BusNetwork::show() {
-  if (!_valid || !canShow()) return;
+  if (!_valid) return;
+  if (!canShow()) {
+    _framesSkipped++; // previous frame is still being sent
+    return;
+  }
   _broadcastLock = true;
-  realtimeBroadcast(_UDPtype, _client, _len, _data, _bri, hasWhite());
-  _broadcastLock = false;
+  _sendBri = _bri;
+  #ifdef ARDUINO_ARCH_ESP32
+  if (_sendData != _data) {
+    BusNetwork *bus = this;
+    memcpy(_sendData, _data, _len * _UDPchannels);
+    if (xQueueSend(_sendQueue, &bus, 0) != pdTRUE) {
+      _framesSkipped++;
+      _broadcastLock = false;
+    }
+    return;
+  }
+  #endif
+  send();
 }
 
 size_t BusNetwork::getPins(uint8_t* pinArray) const {
@@ -791,6 +909,7 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
   return {
     {TYPE_NET_DDP_RGB,     "N",     PSTR("DDP RGB (network)")},      // should be "NNNN" to determine 4 "pin" fields
     {TYPE_NET_ARTNET_RGB,  "N",     PSTR("Art-Net RGB (network)")},
+    {TYPE_NET_E131_RGB,    "N",     PSTR("E1.31 RGB (network)")},
     {TYPE_NET_DDP_RGBW,    "N",     PSTR("DDP RGBW (network)")},
     {TYPE_NET_ARTNET_RGBW, "N",     PSTR("Art-Net RGBW (network)")},
     // hypothetical extensions
@@ -803,8 +922,13 @@ std::vector<LEDType> BusNetwork::getLEDTypes() {
 
 void BusNetwork::cleanup() {
   DEBUGBUS_PRINTLN(F("Virtual Cleanup."));
+  while (_broadcastLock) yield(); // wait for sender task to finish with buffers
+  if (_sendData != _data) d_free(_sendData);
   d_free(_data);
+  d_free(_packet);
   _data = nullptr;
+  _sendData = nullptr;
+  _packet = nullptr;
   _type = I_NONE;
   _valid = false;
 }
@@ -1449,6 +1573,22 @@ void IRAM_ATTR BusManager::setPixelColor(unsigned pix, uint32_t c) {
   }
 }
 
+// each bus covers a contiguous range of strip pixels so the whole strip can be handed over bus by bus
+// note: BusDigital cannot be updated partially as NeoPixelBus may swap buffers in Show() if consistency is not requested
+void BusManager::setPixelColors(const uint32_t *c, unsigned len, bool gamma, unsigned dmgStart, unsigned dmgStop) {
+  for (auto &bus : busses) {
+    unsigned start = bus->getStart();
+    unsigned stop  = std::min(start + bus->getLength(), len);
+    if (start >= stop) continue;
+    if (bus->supportsPartialUpdate()) {
+      start = std::max(start, dmgStart);
+      stop  = std::min(stop, dmgStop);
+      if (start >= stop) continue; // bus content did not change
+    }
+    bus->setPixelColors(start - bus->getStart(), c + start, stop - start, gamma);
+  }
+}
+
 void BusManager::setSegmentCCT(int16_t cct, bool allowWBCorrection) {
   if (cct > 255) cct = 255;
   if (cct >= 0) {
@@ -1466,8 +1606,9 @@ uint32_t BusManager::getPixelColor(unsigned pix) {
   return 0;
 }
 
-bool BusManager::canAllShow() {
-  for (const auto &bus : busses) if (!bus->canShow()) return false;
+// onlyPhysical: ignore network buses (still sending asynchronously does not interfere with RMT/FS access)
+bool BusManager::canAllShow(bool onlyPhysical) {
+  for (const auto &bus : busses) if (!(bus->isVirtual() && onlyPhysical) && !bus->canShow()) return false;
   return true;
 }
 
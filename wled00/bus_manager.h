@@ -132,6 +132,7 @@ class Bus {
     virtual bool     canShow() const                            { return true; }
     virtual void     setStatusPixel(uint32_t c)                 {}
     virtual void     setPixelColor(unsigned pix, uint32_t c)    = 0;
+    virtual void     setPixelColors(unsigned pix, const uint32_t *c, unsigned len, bool gamma); // sets pixels [pix,pix+len) of the bus from an array (optionally gamma corrected)
     virtual void     setBrightness(uint8_t b)                   { _bri = b; };
     virtual void     setColorOrder(uint8_t co)                  {}
     virtual uint32_t getPixelColor(unsigned pix) const          { return 0; }
@@ -144,6 +145,10 @@ class Bus {
     virtual uint16_t getUsedCurrent() const                     { return 0; }
     virtual uint16_t getMaxCurrent() const                      { return 0; }
     virtual uint8_t  getDriverType() const                      { return 0; } // Default to RMT (0) for non-digital buses
+    virtual uint16_t getUniverse() const                        { return 0; } // E1.31 network buses only
+    virtual uint8_t  getPriority() const                        { return 0; }
+    virtual uint16_t getSyncUniverse() const                    { return 0; }
+    virtual bool     supportsPartialUpdate() const              { return false; } // true if unchanged pixels retain their value across show() (only changed span needs updating)
     virtual size_t   getBusSize() const                         { return sizeof(Bus); } // currently unused
     virtual const String getCustomText() const                  { return String(); }
 
@@ -254,6 +259,7 @@ class BusDigital : public Bus {
     bool canShow() const override;
     void setStatusPixel(uint32_t c) override;
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
+    [[gnu::hot]] void setPixelColors(unsigned pix, const uint32_t *c, unsigned len, bool gamma) override;
     void setColorOrder(uint8_t colorOrder) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     uint8_t  getColorOrder() const override  { return _colorOrder; }
@@ -286,9 +292,13 @@ class BusDigital : public Bus {
     uint16_t _milliAmpsLimit;
     uint32_t _colorSum; // total color value for the bus, updated in setPixelColor(), used to estimate current
     void    *_busPtr;
+    std::vector<ColorOrderMapEntry> _colorOrderRuns; // color order of consecutive physical pixels (including skipped), avoids ColorOrderMap lookup per pixel
 
     static uint16_t _milliAmpsTotal; // is overwitten/recalculated on each show()
 
+    void updateColorOrderRuns();
+    [[gnu::hot]] uint32_t prepareColor(uint32_t c, uint16_t &wwcw); // applies CCT, auto white, brightness & ABL accounting
+
     inline uint32_t restoreColorLossy(uint32_t c, uint8_t restoreBri) const {
       if (restoreBri < 255) {
         uint8_t* chan = (uint8_t*) &c;
@@ -356,28 +366,47 @@ class BusNetwork : public Bus {
     ~BusNetwork() { cleanup(); }
 
     bool canShow() const override  { return !_broadcastLock; } // this should be a return value from UDP routine if it is still sending data out
+    bool supportsPartialUpdate() const override { return true; } // _data[] persists between frames
     [[gnu::hot]] void setPixelColor(unsigned pix, uint32_t c) override;
     [[gnu::hot]] uint32_t getPixelColor(unsigned pix) const override;
     size_t getPins(uint8_t* pinArray = nullptr) const override;
-    size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels : 0); }
+    size_t getBusSize() const override  { return sizeof(BusNetwork) + (isOk() ? _len * _UDPchannels * (1 + (_sendData != _data)) + _packetSize : 0); }
     void   show() override;
     void   cleanup();
     #ifdef ARDUINO_ARCH_ESP32
     void   resolveHostname();
     const String getCustomText() const override { return _hostname; }
     #endif
+    uint16_t getUniverse() const override     { return _universe; }
+    uint8_t  getPriority() const override     { return _priority; }
+    uint16_t getSyncUniverse() const override { return _syncUniverse; }
 
     static std::vector<LEDType> getLEDTypes();
+    static uint32_t getSendTime()      { return _sendTime; }      // average time needed to send a frame (us)
+    static uint32_t getFramesSkipped() { return _framesSkipped; } // frames not sent because previous frame was still being sent
 
   private:
     IPAddress _client;
     uint8_t   _UDPtype;
     uint8_t   _UDPchannels;
-    bool      _broadcastLock;
+    uint8_t   _sendBri;     // brightness of frame in _sendData
+    volatile bool _broadcastLock;
     uint8_t   *_data;
+    uint8_t   *_sendData;   // frame being sent, separate buffer if sending asynchronously (ESP32), same as _data otherwise
+    uint8_t   *_packet;     // UDP packet assembly buffer (header + channel data of one packet)
+    size_t    _packetSize;
+    uint16_t  _universe;     // E1.31: first universe, following universes are used if more than 512 channels are sent
+    uint8_t   _priority;     // E1.31: source priority (0-200)
+    uint16_t  _syncUniverse; // E1.31: universe for synchronization packets (0 = no synchronization)
     #ifdef ARDUINO_ARCH_ESP32
     String    _hostname;
+    static QueueHandle_t _sendQueue; // network buses with a frame ready to be sent
+    static void sendTask(void *);
     #endif
+    static uint32_t _sendTime;
+    static uint32_t _framesSkipped;
+
+    void send();
 };
 
 // Placeholder for buses that we can't construct due to resource limitations
@@ -468,6 +497,9 @@ struct BusConfig {
   uint8_t driverType; // 0=RMT (default), 1=I2S
   uint8_t iType; // internal bus type (I_*) determined during memory estimation, used for bus creation
   String text;
+  uint16_t universe = 1;     // E1.31 network bus: first universe
+  uint8_t priority = 100;    // E1.31 network bus: source priority (0-200)
+  uint16_t syncUniverse = 0; // E1.31 network bus: synchronization universe (0 = none)
 
   BusConfig(uint8_t busType, uint8_t* ppins, uint16_t pstart, uint16_t len = 1, uint8_t pcolorOrder = COL_ORDER_GRB, bool rev = false, uint8_t skip = 0, byte aw=RGBW_MODE_MANUAL_ONLY, uint16_t clock_kHz=0U, uint8_t maPerLed=LED_MILLIAMPS_DEFAULT, uint16_t maMax=ABL_MILLIAMPS_DEFAULT, uint8_t driver=0, String sometext = "")
   : count(std::max(len,(uint16_t)1))
@@ -560,9 +592,11 @@ namespace BusManager {
   void off();
 
   [[gnu::hot]] void     setPixelColor(unsigned pix, uint32_t c);
+  // sets pixels [0,len) of all buses at once (no ledmap), buses supporting partial update only receive damaged range [dmgStart,dmgStop)
+  [[gnu::hot]] void     setPixelColors(const uint32_t *c, unsigned len, bool gamma, unsigned dmgStart = 0, unsigned dmgStop = UINT16_MAX);
   [[gnu::hot]] uint32_t getPixelColor(unsigned pix);
   void        show();
-  bool        canAllShow();
+  bool        canAllShow(bool onlyPhysical = false);
   inline void setStatusPixel(uint32_t c) { for (auto &bus : busses) bus->setStatusPixel(c);}
   inline void setBrightness(uint8_t b)   { for (auto &bus : busses) bus->setBrightness(b); }
   // for setSegmentCCT(), cct can only be in [-1,255] range; allowWBCorrection will convert it to K
@@ -258,6 +258,11 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
 
       String host = elm[F("text")] | String();
       busConfigs.emplace_back(ledType, pins, start, length, colorOrder, reversed, skipFirst, AWmode, freqkHz, maPerLed, maMax, driverType, host);
+      if ((ledType & 0x7F) == TYPE_NET_E131_RGB) {
+        busConfigs.back().universe     = elm[F("uni")]  | 1;
+        busConfigs.back().priority     = elm[F("prio")] | 100;
+        busConfigs.back().syncUniverse = elm[F("sync")] | 0;
+      }
       doInitBusses = true;  // finalization done in beginStrip()
       if (!Bus::isVirtual(ledType)) s++; // have as many virtual buses as you want
     }
@@ -525,6 +530,9 @@ bool deserializeConfig(JsonObject doc, bool fromFS) {
   CJSON(briMultiplier, light[F("scale-bri")]);
   CJSON(paletteBlend, light[F("pal-mode")]);
   CJSON(strip.autoSegments, light[F("aseg")]);
+  bool psGrid = particleCollisionGrid;
+  CJSON(particleCollisionGrid, light[F("psgrid")]);
+  if (psGrid != particleCollisionGrid) strip.restartRuntime(); // particle systems reserve grid memory when created
 
   CJSON(gammaCorrectVal, light["gc"]["val"]); // default 2.2
   float light_gc_bri = light["gc"]["bri"] | 1.0f; // default to 1.0 (false)
@@ -1015,6 +1023,11 @@ void serializeConfig(JsonObject root) {
     ins[F("ledma")]  = bus->getLEDCurrent();
     ins[F("drv")]    = bus->getDriverType();
     ins[F("text")]   = bus->getCustomText();
+    if ((bus->getType() & 0x7F) == TYPE_NET_E131_RGB) {
+      ins[F("uni")]  = bus->getUniverse();
+      ins[F("prio")] = bus->getPriority();
+      ins[F("sync")] = bus->getSyncUniverse();
+    }
   }
 
   JsonArray hw_com = hw.createNestedArray(F("com"));
@@ -1079,6 +1092,7 @@ void serializeConfig(JsonObject root) {
   light[F("scale-bri")] = briMultiplier;
   light[F("pal-mode")] = paletteBlend;
   light[F("aseg")] = strip.autoSegments;
+  light[F("psgrid")] = particleCollisionGrid;
 
   JsonObject light_gc = light.createNestedObject("gc");
   light_gc["bri"] = (gammaCorrectBri) ? gammaCorrectVal : 1.0f;  // keep compatibility
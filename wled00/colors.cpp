@@ -98,6 +98,194 @@ uint32_t IRAM_ATTR color_fade(uint32_t c1, uint8_t amount, bool video) {
   return (rb_scaled | wg_scaled);
 }
 
+/*
+ * pixel span kernels
+ * used by segment fill/fade/blur functions and blendSegment(), each call processes a whole row or buffer
+ * R & B and W & G are processed as two 16bit lanes per 32bit word (same as color_blend() & co.)
+ */
+static inline uint32_t add_saturate(uint32_t c1, uint32_t c2) { // same as color_add(c1, c2, false)
+  const uint32_t TWO_CHANNEL_MASK = 0x00FF00FF;
+  uint32_t rb = ( c1     & TWO_CHANNEL_MASK) + ( c2     & TWO_CHANNEL_MASK);
+  uint32_t wg = ((c1>>8) & TWO_CHANNEL_MASK) + ((c2>>8) & TWO_CHANNEL_MASK);
+  rb |= ((rb & 0x01000100) - ((rb >> 8) & 0x00010001)) & TWO_CHANNEL_MASK;
+  wg |= ((wg & 0x01000100) - ((wg >> 8) & 0x00010001)) & TWO_CHANNEL_MASK;
+  return rb | (wg << 8);
+}
+
+bool WLED_O2_ATTR span_fill(uint32_t *p, size_t n, uint32_t c) {
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    diff |= p[i] ^ c;
+    p[i] = c;
+  }
+  return diff;
+}
+
+bool WLED_O2_ATTR span_scale(uint32_t *p, size_t n, uint8_t scale) {
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t c  = p[i];
+    const uint32_t rb = (((c     & 0x00FF00FF) * scale) >> 8) &  0x00FF00FF;
+    const uint32_t wg = (((c>>8) & 0x00FF00FF) * scale)       & ~0x00FF00FF;
+    diff |= c ^ (rb | wg);
+    p[i] = rb | wg;
+  }
+  return diff;
+}
+
+// (c1<<8 | c2) + c2*blend - c1*blend == c1*(256-blend) + c2*(blend+1) per lane: color dependent terms are calculated once
+bool IRAM_ATTR WLED_O2_ATTR span_blend_color(uint32_t *p, size_t n, uint32_t c, uint8_t blend) {
+  const uint32_t inv = 256 - blend;
+  const uint32_t rb2 = ( c       & 0x00FF00FF) * (blend + 1);
+  const uint32_t wg2 = ((c >> 8) & 0x00FF00FF) * (blend + 1);
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t c1 = p[i];
+    const uint32_t rb = ((( c1       & 0x00FF00FF) * inv + rb2) >> 8) &  0x00FF00FF;
+    const uint32_t wg = ((((c1 >> 8) & 0x00FF00FF) * inv + wg2))      & ~0x00FF00FF;
+    diff |= c1 ^ (rb | wg);
+    p[i] = rb | wg;
+  }
+  return diff;
+}
+
+// per channel: delta = (c - p)*rate/256 (truncated toward zero), at least 1 if p != c; rate 1-256
+// lanes are biased by 256 so differences never borrow from the neighbouring lane
+static inline uint32_t fade_lanes(uint32_t a, uint32_t b, unsigned rate) {
+  const uint32_t x    = (b + 0x01000100) - a;                        // 256 + b - a per lane
+  const uint32_t down = ((~x >> 8) & 0x00010001) * 0xFF;             // 0xFF in lanes where b < a
+  const uint32_t dist = ((x & 0x00FF00FF) ^ down) + (down & 0x00010001); // |b - a|
+  uint32_t d = ((dist * rate) >> 8) & 0x00FF00FF;
+  const uint32_t nonZero = ((dist + 0x00FF00FF) >> 8) & 0x00010001;  // dist > 0
+  const uint32_t zero    = ~((d    + 0x00FF00FF) >> 8) & 0x00010001;  // d == 0
+  d |= nonZero & zero;
+  return a + (d & ~down) - (d & down);
+}
+
+bool WLED_O2_ATTR span_fade_toward(uint32_t *p, size_t n, uint32_t c, unsigned rate) {
+  const uint32_t rb2 =  c       & 0x00FF00FF;
+  const uint32_t wg2 = (c >> 8) & 0x00FF00FF;
+  uint32_t diff = 0;
+  for (size_t i = 0; i < n; i++) {
+    const uint32_t c1 = p[i];
+    if (c1 == c) continue; // already at target color (common once fade is complete)
+    const uint32_t r  = fade_lanes(c1 & 0x00FF00FF, rb2, rate) | (fade_lanes((c1 >> 8) & 0x00FF00FF, wg2, rate) << 8);
+    diff |= c1 ^ r;
+    p[i] = r;
+  }
+  return diff;
+}
+
+// each pixel keeps keep/256 of its color and gives seep/256 to both neighbours (FastLED blur1d)
+bool WLED_O2_ATTR span_blur(uint32_t *p, size_t n, ptrdiff_t stride, uint8_t keep, uint8_t seep) {
+  if (n == 0) return false;
+  uint32_t old   = p[0];
+  uint32_t carry = fast_color_scale(old, seep);
+  uint32_t prev  = fast_color_scale(old, keep); // value of previous pixel, still missing the part from current one
+  uint32_t diff  = 0;
+  uint32_t *q = p;
+  for (size_t i = 1; i < n; i++) {
+    uint32_t *next = q + stride;
+    const uint32_t cur  = *next;
+    const uint32_t part = fast_color_scale(cur, seep);
+    const uint32_t out  = add_saturate(prev, part);
+    diff |= old ^ out;
+    *q = out;
+    prev  = add_saturate(fast_color_scale(cur, keep), carry);
+    carry = part;
+    old   = cur;
+    q     = next;
+  }
+  diff |= old ^ prev;
+  *q = prev;
+  return diff;
+}
+
+void IRAM_ATTR WLED_O2_ATTR span_blend(uint32_t *dst, ptrdiff_t dstStep, const uint32_t *src, size_t n, uint8_t blend) {
+  if (blend == 255) { // color_blend(a, b, 255) == b
+    for (size_t i = 0; i < n; i++, dst += dstStep) *dst = src[i];
+    return;
+  }
+  const uint32_t inv = 256 - blend;
+  for (size_t i = 0; i < n; i++, dst += dstStep) {
+    const uint32_t c1 = *dst, c2 = src[i];
+    const uint32_t rb = ((( c1       & 0x00FF00FF) * inv + ( c2       & 0x00FF00FF) * (blend + 1)) >> 8) &  0x00FF00FF;
+    const uint32_t wg = ((((c1 >> 8) & 0x00FF00FF) * inv + ((c2 >> 8) & 0x00FF00FF) * (blend + 1)))      & ~0x00FF00FF;
+    *dst = rb | wg;
+  }
+}
+
+// same result as span_blur(&p[x], rows, cols, keep, seep) for each column x, but memory is accessed row by row
+bool WLED_O2_ATTR span_blur_columns(uint32_t *p, size_t cols, size_t rows, uint8_t keep, uint8_t seep) {
+  if (rows == 0) return false;
+  uint32_t old[SPAN_TILE_COLS], carry[SPAN_TILE_COLS], prev[SPAN_TILE_COLS]; // per column state, see span_blur()
+  uint32_t diff = 0;
+  for (size_t x0 = 0; x0 < cols; x0 += SPAN_TILE_COLS) {
+    const size_t w = (cols - x0 < SPAN_TILE_COLS) ? cols - x0 : SPAN_TILE_COLS;
+    uint32_t *row = p + x0;
+    for (size_t c = 0; c < w; c++) {
+      old[c]   = row[c];
+      carry[c] = fast_color_scale(old[c], seep);
+      prev[c]  = fast_color_scale(old[c], keep);
+    }
+    for (size_t y = 1; y < rows; y++) {
+      uint32_t *next = row + cols;
+      for (size_t c = 0; c < w; c++) {
+        const uint32_t cur  = next[c];
+        const uint32_t part = fast_color_scale(cur, seep);
+        const uint32_t out  = add_saturate(prev[c], part);
+        diff |= old[c] ^ out;
+        row[c]   = out;
+        prev[c]  = add_saturate(fast_color_scale(cur, keep), carry[c]);
+        carry[c] = part;
+        old[c]   = cur;
+      }
+      row = next;
+    }
+    for (size_t c = 0; c < w; c++) {
+      diff |= old[c] ^ prev[c];
+      row[c] = prev[c];
+    }
+  }
+  return diff;
+}
+
+// moves whole rows (contiguous memory): non-wrapping moves leave vacated rows unchanged, wrapping moves rotate rows in place
+bool WLED_O2_ATTR span_move_rows(uint32_t *p, size_t cols, size_t rows, int delta, bool wrap) {
+  const size_t absDelta = abs(delta);
+  if (delta == 0 || absDelta >= rows) return false;
+  const size_t rowBytes = cols * sizeof(uint32_t);
+  bool changed = false;
+  if (!wrap) {
+    uint32_t *dst = delta > 0 ? p : p + absDelta * cols;
+    uint32_t *src = delta > 0 ? p + absDelta * cols : p;
+    const size_t bytes = (rows - absDelta) * rowBytes;
+    changed = memcmp(dst, src, bytes) != 0;
+    memmove(dst, src, bytes);
+    return changed;
+  }
+  // row y receives row (y + shift) % rows: follow each cycle of the permutation, one row is held in tmp
+  const size_t shift = (delta + int(rows)) % int(rows);
+  size_t a = rows, b = shift; // number of cycles is gcd(rows, shift)
+  while (b) { size_t t = a % b; a = b; b = t; }
+  uint32_t tmp[cols];
+  for (size_t s = 0; s < a; s++) {
+    memcpy(tmp, p + s * cols, rowBytes);
+    size_t j = s;
+    for (;;) {
+      size_t k = j + shift;
+      if (k >= rows) k -= rows;
+      if (k == s) break;
+      changed |= memcmp(p + j * cols, p + k * cols, rowBytes) != 0;
+      memcpy(p + j * cols, p + k * cols, rowBytes);
+      j = k;
+    }
+    changed |= memcmp(p + j * cols, tmp, rowBytes) != 0;
+    memcpy(p + j * cols, tmp, rowBytes);
+  }
+  return changed;
+}
+
 /*
  * color adjustment in HSV color space (converts RGB to HSV and back), color conversions are not 100% accurate!
  * shifts hue, increase brightness, decreases saturation (if not black)
@@ -99,6 +99,20 @@ static inline uint32_t fast_color_scale(const uint32_t c, const uint8_t scale) {
   return rb | wg;
 }
 
+// pixel span kernels: operate on runs of RGBW32 pixels (segment and frame buffers), results are identical to the
+// per-pixel functions noted (two channels per 32bit word, loops are simple enough to be auto-vectorized on other targets)
+// all kernels return true if any pixel changed (for damage tracking)
+bool span_fill(uint32_t *p, size_t n, uint32_t c);                                    // p[i] = c
+bool span_scale(uint32_t *p, size_t n, uint8_t scale);                                // fast_color_scale(p[i], scale)
+bool span_blend_color(uint32_t *p, size_t n, uint32_t c, uint8_t blend);              // color_blend(p[i], c, blend)
+bool span_fade_toward(uint32_t *p, size_t n, uint32_t c, unsigned rate);              // move each channel rate/256 (at least 1) toward c
+bool span_blur(uint32_t *p, size_t n, ptrdiff_t stride, uint8_t keep, uint8_t seep);  // 1D blur along p[i*stride], see Segment::blur()
+void span_blend(uint32_t *dst, ptrdiff_t dstStep, const uint32_t *src, size_t n, uint8_t blend); // dst[i*dstStep] = color_blend(dst[..], src[i], blend)
+// column passes over a cols x rows buffer: walk rows of SPAN_TILE_COLS columns at once instead of striding through each column
+#define SPAN_TILE_COLS 16 // 64 bytes per tile row (cache line)
+bool span_blur_columns(uint32_t *p, size_t cols, size_t rows, uint8_t keep, uint8_t seep); // span_blur() on every column
+bool span_move_rows(uint32_t *p, size_t cols, size_t rows, int delta, bool wrap);          // row y = row y+delta, see Segment::moveY()
+
 // palettes
 extern const TProgmemRGBPalette16 PartyColors_gc22 PROGMEM;
 extern const TProgmemRGBPalette16* const fastledPalettes[];
@@ -384,7 +384,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 //Network types (master broadcast) (80-95)
 #define TYPE_VIRTUAL_MIN         80
 #define TYPE_NET_DDP_RGB         80            //network DDP RGB bus (master broadcast bus)
-#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus, unused)
+#define TYPE_NET_E131_RGB        81            //network E131 RGB bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGB      82            //network ArtNet RGB bus (master broadcast bus, unused)
 #define TYPE_NET_DDP_RGBW        88            //network DDP RGBW bus (master broadcast bus)
 #define TYPE_NET_ARTNET_RGBW     89            //network ArtNet RGB bus (master broadcast bus, unused)
@@ -531,6 +531,7 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
 #define JSON_LOCK_LEDMAP_ENUM     21
 #define JSON_LOCK_REMOTE          22
 #define JSON_LOCK_OTA             23
+#define JSON_LOCK_MODULES         24 // number of lock owners above (for statistics)
 
 // Timer mode types
 #define NL_MODE_SET               0            //After nightlight time elapsed, set to target brightness
@@ -662,6 +663,19 @@ static_assert(WLED_MAX_BUSSES <= 32, "WLED_MAX_BUSSES exceeds hard limit");
   #endif
 #endif
 
+// number of additional JSON documents for state/info serialization (HTTP JSON GET state/info, WebSocket updates)
+// state is generated part by part (see serializeStatePart()) so these only need to hold the largest part (info)
+#ifndef WLED_JSON_POOL_SIZE
+  #ifdef ESP8266
+    #define WLED_JSON_POOL_SIZE 0 // not enough RAM, everything uses the global JSON buffer
+  #else
+    #define WLED_JSON_POOL_SIZE 2
+  #endif
+#endif
+#ifndef JSON_POOL_DOC_SIZE
+  #define JSON_POOL_DOC_SIZE 8192 // if a part does not fit, the global JSON buffer is used instead
+#endif
+
 // minimum heap size required to process web requests: try to keep free heap above this value
 #ifdef ESP8266
   #define MIN_HEAP_SIZE (9*1024)
@@ -250,6 +250,34 @@ function sendDDP(ws, start, len, colors, isESP8266=false) {
 	return true;
 }
 
+// decode live view v3 frame (see sendLiveLeds3() in ws.cpp)
+// b: Uint8Array of received frame
+// f: previously decoded frame (delta frames are applied to it)
+// returns Uint8Array with RGB values (3*w*h bytes), f.w and f.h are set to frame dimensions
+function decodeLive3(b, f) {
+	let w = (b[3] << 8) | b[4], h = (b[5] << 8) | b[6], len = w * h;
+	if (!(b[2] & 1) || !f || f.length != len * 3) f = new Uint8Array(len * 3); // key frame or missed key frame
+	f.w = w; f.h = h;
+	let c565 = b[2] & 2, p = 7, i = 0, r, g, bl;
+	let col = () => {
+		if (c565) {
+			r = b[p] & 0xF8; g = ((b[p] << 5) | (b[p+1] >> 3)) & 0xFC; bl = (b[p+1] << 3) & 0xF8; p += 2;
+			r |= r >> 5; g |= g >> 6; bl |= bl >> 5;
+		} else {
+			r = b[p++]; g = b[p++]; bl = b[p++];
+		}
+	};
+	let put = () => { if (i < len) { f[i*3] = r; f[i*3+1] = g; f[i*3+2] = bl; } i++; };
+	while (p < b.length && i < len) {
+		let c = b[p++];
+		if (c & 0x80) { i += (c & 0x7F) + 1; continue; } // unchanged pixels
+		let n = (c & 0x3F) + 1;
+		if (c & 0x40) { col(); while (n--) put(); }      // n pixels of one color
+		else while (n--) { col(); put(); }              // n colors
+	}
+	return f;
+}
+
 // Pin utilities
 function getOwnerName(o,t,n) {
 	// Use firmware-provided name if available
@@ -84,9 +84,7 @@ static void handleDDPPacket(e131_packet_t* p, size_t packetLen) {
   realtimeLock(realtimeTimeoutMs, REALTIME_MODE_DDP);
 
   if (!realtimeOverride) {
-    for (unsigned i = start; i < stop; i++, c += ddpChannelsPerLed) {
-      setRealtimePixel(i, data[c], data[c+1], data[c+2], ddpChannelsPerLed >3 ? data[c+3] : 0);
-    }
+    setRealtimePixels(start, &data[c], numLeds, ddpChannelsPerLed);
   }
 
   ddpSeenPush |= push;
@@ -368,10 +366,7 @@ void handleDMXData(uint16_t uni, uint16_t dmxChannels, uint8_t* e131_data, uint8
           }
         }
 
-        for (unsigned i = previousLeds; i < ledsTotal; i++) {
-          setRealtimePixel(i, e131_data[dmxOffset], e131_data[dmxOffset+1], e131_data[dmxOffset+2], is4Chan ? e131_data[dmxOffset+3] : 0);
-          dmxOffset += dmxChannelsPerLed;
-        }
+        if (ledsTotal > previousLeds) setRealtimePixels(previousLeds, &e131_data[dmxOffset], ledsTotal - previousLeds, dmxChannelsPerLed);
         break;
       }
     default:
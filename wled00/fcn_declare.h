@@ -125,6 +125,7 @@ void updateFSInfo();
 size_t getFsBytesUsed();
 size_t getFsBytesTotal();
 void closeFile();
+void invalidatePresetIndex();
 inline bool writeObjectToFileUsingId(const String &file, uint16_t id, const JsonDocument* content) { return writeObjectToFileUsingId(file.c_str(), id, content); };
 inline bool writeObjectToFile(const String &file, const char* key, const JsonDocument* content) { return writeObjectToFile(file.c_str(), key, content); };
 inline bool readObjectFromFileUsingId(const String &file, uint16_t id, JsonDocument* dest, const JsonDocument* filter = nullptr) { return readObjectFromFileUsingId(file.c_str(), id, dest); };
@@ -186,6 +187,10 @@ bool deserializeState(JsonObject root, byte callMode = CALL_MODE_DIRECT_CHANGE,
 void serializeSegment(const JsonObject& root, const Segment& seg, byte id, bool forPreset = false, bool segmentBounds = true);
 void serializeState(JsonObject root, bool forPreset = false, bool includeBri = true, bool segmentBounds = true, bool selectedSegmentsOnly = false);
 void serializeInfo(JsonObject root);
+#define JSON_STREAM_OVERFLOW SIZE_MAX // returned by serializeStateStream()/serializeStateDelta() if doc was too small
+size_t serializeStatePart(Print &out, JsonDocument &doc, bool state, bool info, unsigned &part);
+size_t serializeStateStream(Print &out, JsonDocument &doc, bool state = true, bool info = true);
+size_t serializeStateDelta(Print &out, JsonDocument &doc, bool reset = false);
 void serializeModeNames(JsonArray arr);
 void serializePins(JsonObject root);
 void serveJson(AsyncWebServerRequest* request);
@@ -193,6 +198,13 @@ void serveJson(AsyncWebServerRequest* request);
 bool serveLiveLeds(AsyncWebServerRequest* request, uint32_t wsClient = 0);
 #endif
 
+//fx_bench.cpp
+#ifdef WLED_ENABLE_FX_BENCHMARK
+void startFxBenchmark(JsonObject bench);
+void handleFxBenchmark();
+void serializeFxBenchmark(JsonObject root);
+#endif
+
 //led.cpp
 void setValuesFromSegment(uint8_t s);
 #define setValuesFromMainSeg()          setValuesFromSegment(strip.getMainSegmentId())
@@ -276,6 +288,7 @@ void serializePlaylist(JsonObject obj);
 //presets.cpp
 const char *getPresetsFileName(bool persistent = true);
 bool presetNeedsSaving();
+void clearPresetCache();
 void initPresetsFile();
 void handlePresets();
 bool applyPreset(byte index, byte callMode = CALL_MODE_DIRECT_CHANGE);
@@ -301,11 +314,14 @@ uint16_t getRolloverMillis();
 
 //udp.cpp
 void notify(byte callMode, bool followUp=false);
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t bri=255, bool isRGBW=false);
+size_t realtimeBroadcastBufferSize(uint8_t type, size_t channelCount);
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t* buffer, uint8_t* packet, uint8_t bri=255, bool isRGBW=false, uint16_t universe=1, uint8_t priority=100, uint16_t syncUniverse=0);
 void realtimeLock(uint32_t timeoutMs, byte md = REALTIME_MODE_GENERIC);
 void exitRealtime();
 void handleNotifications();
+void serializeUdpStats(JsonArray stats);
 void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w);
+void setRealtimePixels(uint16_t i, const uint8_t *data, unsigned count, unsigned channels = 3);
 void refreshNodeList();
 void sendSysInfoUDP();
 #ifndef WLED_DISABLE_ESPNOW
@@ -460,6 +476,9 @@ uint32_t utf8_decode(const char *s, uint8_t *len);
 size_t utf8_strlen(const char *s);
 bool requestJSONBufferLock(uint8_t moduleID=JSON_LOCK_UNKNOWN);
 void releaseJSONBufferLock();
+JsonDocument *requestJSONDocument(uint8_t moduleID=JSON_LOCK_UNKNOWN);
+void releaseJSONDocument(JsonDocument *doc);
+void serializeJSONBufferStats(JsonObject root);
 uint8_t extractModeName(uint8_t mode, const char *src, char *dest, uint8_t maxLen);
 uint8_t extractModeSlider(uint8_t mode, uint8_t slider, char *dest, uint8_t maxLen, uint8_t *var = nullptr);
 int16_t extractModeDefaults(uint8_t mode, const char *segVar);
@@ -480,6 +499,7 @@ uint8_t beatsin8_t(uint16_t beats_per_minute, uint8_t lowest = 0, uint8_t highes
 
 um_data_t* simulateSound(uint8_t simulationId);
 void enumerateLedmaps();
+void invalidateLedmapCache(const String &fileName);
 [[gnu::hot]] uint8_t get_random_wheel_index(uint8_t pos);
 [[gnu::hot, gnu::pure]] float mapf(float x, float in_min, float in_max, float out_min, float out_max);
 uint32_t hashInt(uint32_t s);
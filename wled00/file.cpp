@@ -157,6 +157,7 @@ static bool bufferedFindObjectEnd() {
     size_t count = 0;
 
     while (count < bufsize) {
+      if (objDepth == 0 && isspace(buf[count])) { count++; continue; } // whitespace between key and value
       if (buf[count] == '{') objDepth++;
       if (buf[count] == '}') objDepth--;
       if (objDepth == 0) {
@@ -186,7 +187,182 @@ static void writeSpace(size_t l)
   if (knownLargestSpace < l) knownLargestSpace = l;
 }
 
-static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0)
+/*
+ * Preset index
+ * Keeps position and length of every preset object in presets.json so a preset can be loaded with a single
+ * seek+read instead of scanning the file from the start, and a short list of the largest holes (runs of spaces
+ * left behind by deleted or shrunk presets) so saving a preset does not need to scan the file for free space.
+ * The index is built with one pass over the file on first access (usually the boot preset) and kept up to date
+ * by writeObjectToFile(). It is rebuilt if the file size changed or an entry does not match the file (upload, editor),
+ * and once before a preset missing from the index is reported as not found.
+ */
+#define PRESET_INDEX_SIZE    251 // preset ids 0-250, temporary presets (251-255) live in tmp.json or RAM
+#define PRESET_INDEX_HOLES    16 // number of free space entries kept
+#define PRESET_INDEX_MIN_HOLE 16 // smaller holes are not tracked
+
+typedef struct {
+  uint32_t offset; // position right after the key (where bufferedFind(key) leaves the file), 0 if preset does not exist
+  uint16_t length; // length from offset to closing '}' (inclusive)
+} preset_index_t;
+
+typedef struct {
+  uint32_t offset;
+  uint32_t length; // 0 if unused
+} preset_hole_t;
+
+static preset_index_t *presetIndex = nullptr;
+static preset_hole_t presetHoles[PRESET_INDEX_HOLES];
+static size_t presetIndexFileSize = 0;  // size of presets.json the index refers to
+static bool   presetIndexBuilt = false;
+
+void invalidatePresetIndex() {
+  presetIndexBuilt = false;
+}
+
+// add a hole to the free space list, merging it with adjacent holes; keeps only the largest holes
+static void addPresetHole(size_t offset, size_t length) {
+  for (auto &h : presetHoles) {
+    if (!h.length) continue;
+    if (h.offset + h.length == offset) { offset = h.offset; length += h.length; h.length = 0; }
+    else if (offset + length == h.offset) { length += h.length; h.length = 0; }
+  }
+  if (length < PRESET_INDEX_MIN_HOLE) return;
+  preset_hole_t *smallest = &presetHoles[0];
+  for (auto &h : presetHoles) if (h.length < smallest->length) smallest = &h;
+  if (smallest->length < length) {
+    smallest->offset = offset;
+    smallest->length = length;
+  }
+}
+
+// remove length bytes from the start of a hole (hole has been written to)
+static void usePresetHole(preset_hole_t &h, size_t length) {
+  h.offset += length;
+  h.length  = (h.length > length + PRESET_INDEX_MIN_HOLE) ? h.length - length : 0;
+}
+
+// parse top level of presets.json and record position of all preset objects and holes between them
+static bool buildPresetIndex() {
+  #ifdef WLED_DEBUG_FS
+    DEBUGFS_PRINTLN(F("Build preset index"));
+    uint32_t s = millis();
+  #endif
+  presetIndexBuilt = false;
+  if (!presetIndex) presetIndex = static_cast<preset_index_t*>(d_malloc(PRESET_INDEX_SIZE * sizeof(preset_index_t)));
+  if (!presetIndex) return false; // callers fall back to scanning the file
+  memset(presetIndex, 0, PRESET_INDEX_SIZE * sizeof(preset_index_t));
+  memset(presetHoles, 0, sizeof(presetHoles));
+
+  unsigned depth = 0;
+  bool inString = false, escape = false;
+  int id = -1;          // preset id of the last key string at top level, -1 if key is not a valid id
+  size_t objStart = 0;  // position after ':' of the last key at top level
+  bool inValue = false; // between ':' and the value at top level, spaces there are not free space
+  size_t spaceStart = 0, spaces = 0;
+  size_t pos = 0;
+  byte buf[FS_BUFSIZE];
+  f.seek(0);
+  while (f.available()) {
+    size_t bufsize = f.read(buf, FS_BUFSIZE);
+    if (!bufsize) break;
+    for (size_t count = 0; count < bufsize; count++, pos++) {
+      char c = buf[count];
+      if (inString) {
+        if (escape)         escape = false;
+        else if (c == '\\') escape = true;
+        else if (c == '"')  inString = false;
+        else if (depth == 1 && id >= 0) {
+          id = (c >= '0' && c <= '9') ? id * 10 + (c - '0') : -1;
+          if (id >= PRESET_INDEX_SIZE) id = -1;
+        }
+        continue;
+      }
+      if (depth == 1 && !inValue) {
+        if (c == ' ') {
+          if (!spaces++) spaceStart = pos;
+          continue;
+        }
+        if (spaces) addPresetHole(spaceStart, spaces);
+        spaces = 0;
+      }
+      switch (c) {
+        case '"': inString = true; if (depth == 1) id = 0; break;
+        case ':': if (depth == 1) { objStart = pos + 1; inValue = true; } break;
+        case '{': depth++; inValue = false; break;
+        case ',': if (depth == 1) inValue = false; break;
+        case '}':
+          if (depth == 0) break; // not a valid JSON file, will be fixed on next append
+          if (--depth == 1 && id >= 0 && pos - objStart < UINT16_MAX) {
+            presetIndex[id].offset = objStart;
+            presetIndex[id].length = pos - objStart + 1;
+          }
+          break;
+      }
+    }
+  }
+  presetIndexFileSize = f.size();
+  presetIndexBuilt = true;
+  DEBUGFS_PRINTF("Preset index built, took %lu ms\n", millis() - s);
+  return true;
+}
+
+// position file at the value of the object with the given key
+// uses the preset index if the file is presets.json (id >= 0), otherwise scans the file
+static bool findObject(const char *key, int id) {
+  if (id < 0) return bufferedFind(key);
+  size_t keyLen = strlen(key);
+  for (unsigned pass = 0; pass < 2; pass++) {
+    bool fresh = !(presetIndexBuilt && presetIndexFileSize == f.size());
+    if (fresh && !buildPresetIndex()) return bufferedFind(key); // out of memory
+    size_t offset = presetIndex[id].offset;
+    if (!offset) {
+      if (fresh || pass) return false; // index was built from the file as it is now, preset does not exist
+      // file may have been modified outside of writeObjectToFile() without changing its size: rescan once before reporting a miss
+      DEBUGFS_PRINTLN(F("Preset not in index, rescan"));
+      invalidatePresetIndex();
+      continue;
+    }
+    // validate entry (key right before offset, closing bracket at the end), file may have been modified outside of writeObjectToFile()
+    char buf[12];
+    if (offset > keyLen && keyLen < sizeof(buf) && f.seek(offset - keyLen) && f.read((uint8_t*)buf, keyLen) == keyLen
+        && strncmp(buf, key, keyLen) == 0 && f.seek(offset + presetIndex[id].length - 1) && f.read() == '}') {
+      f.seek(offset);
+      return true;
+    }
+    DEBUGFS_PRINTLN(F("Preset index stale"));
+    invalidatePresetIndex();
+  }
+  return bufferedFind(key); // index does not match the file, scan it (presetIndexBuilt is false so writeObject() won't use the index)
+}
+
+// find a tracked hole large enough for length bytes and check it still contains only spaces
+static preset_hole_t *findPresetHole(size_t length) {
+  preset_hole_t *best = nullptr;
+  for (auto &h : presetHoles) {
+    if (h.length >= length && (!best || h.length < best->length)) best = &h;
+  }
+  if (!best) return nullptr;
+  byte buf[FS_BUFSIZE];
+  size_t l = length;
+  f.seek(best->offset);
+  while (l > 0) {
+    size_t block = (l>FS_BUFSIZE) ? FS_BUFSIZE : l;
+    if (f.read(buf, block) != block) break;
+    size_t count = 0;
+    while (count < block && buf[count] == ' ') count++;
+    if (count < block) break;
+    l -= block;
+  }
+  if (l > 0) {
+    DEBUGFS_PRINTLN(F("Preset hole stale"));
+    invalidatePresetIndex();
+    return nullptr;
+  }
+  f.seek(best->offset);
+  return best;
+}
+
+static bool appendObjectToFile(const char* key, const JsonDocument* content, uint32_t s, uint32_t contentLen = 0, int id = -1)
 {
   #ifdef WLED_DEBUG_FS
     DEBUGFS_PRINTLN(F("Append"));
@@ -200,6 +376,7 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
     strcpy_P(init, PSTR("{\"0\":{}}"));
     f.seek(0, SeekSet);           // rewind to ensure we overwrite from the start, instead of appending
     f.print(init);
+    if (id >= 0) invalidatePresetIndex();
   }
 
   if (content->isNull()) {
@@ -210,7 +387,25 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   //if there is enough empty space in file, insert there instead of appending
   if (!contentLen) contentLen = measureJson(*content);
   DEBUGFS_PRINTF("CLen %d\n", contentLen);
-  if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
+  if (id >= 0 && contentLen >= UINT16_MAX) { invalidatePresetIndex(); id = -1; } // too large to be indexed
+  if (id >= 0 && !(presetIndexBuilt && presetIndexFileSize == f.size())) buildPresetIndex();
+  if (id >= 0 && presetIndexBuilt) {
+    // free space list is complete for holes worth using, no need to scan the file
+    preset_hole_t *hole = findPresetHole(contentLen + strlen(key) + 1);
+    if (hole) {
+      size_t start = hole->offset;
+      if (start > 2) f.write(','); //add comma if not first object
+      f.print(key);
+      presetIndex[id].offset = f.position();
+      presetIndex[id].length = contentLen;
+      serializeJson(*content, f);
+      usePresetHole(*hole, f.position() - start);
+      presetIndexFileSize = f.size();
+      DEBUGFS_PRINTF("Inserted (index), took %lu ms (total %lu)", millis() - s1, millis() - s);
+      doCloseFile = true;
+      return true;
+    }
+  } else if (bufferedFindSpace(contentLen + strlen(key) + 1)) {
     if (f.position() > 2) f.write(','); //add comma if not first object
     f.print(key);
     serializeJson(*content, f);
@@ -253,27 +448,41 @@ static bool appendObjectToFile(const char* key, const JsonDocument* content, uin
   } else { //file content is not valid JSON object
     f.seek(0, SeekSet);
     f.print('{'); //start JSON
+    invalidatePresetIndex();
   }
 
   f.print(key);
+  if (id >= 0 && presetIndexBuilt) {
+    presetIndex[id].offset = f.position();
+    presetIndex[id].length = contentLen;
+  }
 
   //Append object
   serializeJson(*content, f);
   f.write('}');
+  if (id >= 0) presetIndexFileSize = f.size();
 
   doCloseFile = true;
   DEBUGFS_PRINTF("Appended, took %lu ms (total %lu)", millis() - s1, millis() - s);
   return true;
 }
 
+static bool writeObject(const char* file, const char* key, int id, const JsonDocument* content);
+
 bool writeObjectToFileUsingId(const char* file, uint16_t id, const JsonDocument* content)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return writeObjectToFile(file, objKey, content);
+  return writeObject(file, objKey, id, content);
 }
 
 bool writeObjectToFile(const char* file, const char* key, const JsonDocument* content)
+{
+  return writeObject(file, key, -1, content);
+}
+
+// id is only used for the preset index, -1 if key is not a preset id
+static bool writeObject(const char* file, const char* key, int id, const JsonDocument* content)
 {
   uint32_t s = 0; //timing
   #ifdef WLED_DEBUG_FS
@@ -292,15 +501,20 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     return false;
   }
 
-  if (!bufferedFind(key)) //key does not exist in file
+  if (strcmp_P(fileName, getPresetsFileName()) != 0 || id >= PRESET_INDEX_SIZE) id = -1;
+  else if (id < 0) invalidatePresetIndex(); // written without id, index can't follow
+
+  if (!findObject(key, id)) //key does not exist in file
   {
-    return appendObjectToFile(key, content, s);
+    return appendObjectToFile(key, content, s, 0, id);
   }
+  if (!presetIndexBuilt) id = -1; // index could not be allocated
 
   //an object with this key already exists, replace or delete it
   pos = f.position();
   //measure out end of old object
-  bufferedFindObjectEnd();
+  if (id >= 0) f.seek(pos + presetIndex[id].length);
+  else         bufferedFindObjectEnd();
   size_t pos2 = f.position();
 
   uint32_t oldLen = pos2 - pos;
@@ -320,33 +534,55 @@ bool writeObjectToFile(const char* file, const char* key, const JsonDocument* co
     f.seek(pos);
     serializeJson(*content, f);
     writeSpace(pos2 - f.position());
+    if (id >= 0) {
+      presetIndex[id].length = contentLen;
+      addPresetHole(pos + contentLen, oldLen - contentLen);
+    }
   } else if (contentLen && bufferedFindSpace(contentLen - oldLen, false)) { //enough leading spaces to replace
     DEBUGFS_PRINTLN(F("replace (trailing)"));
     f.seek(pos);
     serializeJson(*content, f);
+    if (id >= 0) {
+      presetIndex[id].length = contentLen;
+      for (auto &h : presetHoles) if (h.length && h.offset == pos2) usePresetHole(h, contentLen - oldLen);
+    }
   } else {
     DEBUGFS_PRINTLN(F("delete"));
     pos -= strlen(key);
     if (pos > 3) pos--; //also delete leading comma if not first object
     f.seek(pos);
     writeSpace(pos2 - pos);
-    if (contentLen) return appendObjectToFile(key, content, s, contentLen);
+    if (id >= 0) {
+      presetIndex[id].offset = 0;
+      addPresetHole(pos, pos2 - pos);
+      presetIndexFileSize = f.size();
+    }
+    if (contentLen) return appendObjectToFile(key, content, s, contentLen, id);
   }
+  if (id >= 0) presetIndexFileSize = f.size();
 
   doCloseFile = true;
   DEBUGFS_PRINTF("Replaced/deleted, took %lu ms\n", millis() - s);
   return true;
 }
 
+static bool readObject(const char* file, const char* key, int id, JsonDocument* dest, const JsonDocument* filter);
+
 bool readObjectFromFileUsingId(const char* file, uint16_t id, JsonDocument* dest, const JsonDocument* filter)
 {
   char objKey[10];
   sprintf(objKey, "\"%d\":", id);
-  return readObjectFromFile(file, objKey, dest, filter);
+  return readObject(file, objKey, id, dest, filter);
 }
 
 //if the key is a nullptr, deserialize entire object
 bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, const JsonDocument* filter)
+{
+  return readObject(file, key, -1, dest, filter);
+}
+
+// id is only used for the preset index, -1 if key is not a preset id
+static bool readObject(const char* file, const char* key, int id, JsonDocument* dest, const JsonDocument* filter)
 {
   if (doCloseFile) closeFile();
   #ifdef WLED_DEBUG_FS
@@ -357,7 +593,9 @@ bool readObjectFromFile(const char* file, const char* key, JsonDocument* dest, c
   f = WLED_FS.open(fileName, "r");
   if (!f) return false;
 
-  if (key != nullptr && !bufferedFind(key)) //key does not exist in file
+  if (key == nullptr || id >= PRESET_INDEX_SIZE || strcmp_P(fileName, getPresetsFileName()) != 0) id = -1;
+
+  if (key != nullptr && !findObject(key, id)) //key does not exist in file
   {
     f.close();
     dest->clear();
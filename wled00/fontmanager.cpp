@@ -36,7 +36,7 @@ void FontManager::getFontFileName(uint8_t fontNum, char* buffer, bool scanAll) {
   }
   buffer[0] = '\0'; // invalidate
   #ifdef CONFIG_IDF_TARGET_ESP32C3
-    while (!BusManager::canAllShow()) yield(); // accessing FS causes glitches due to RMT issue on C3 TODO: remove this when fixed
+    while (!BusManager::canAllShow(true)) yield(); // accessing FS causes glitches due to RMT issue on C3 TODO: remove this when fixed
   #endif
   File rootdir = WLED_FS.open("/", "r");
   File rootfile = rootdir.openNextFile();
@@ -167,7 +167,7 @@ void FontManager::rebuildCache(const char* text) {
     getFontFileName(_fontNum, fileName);
 
     #ifdef CONFIG_IDF_TARGET_ESP32C3
-    while (!BusManager::canAllShow()) yield(); // accessing FS causes glitches due to RMT issue on C3 TODO: remove this when fixed
+    while (!BusManager::canAllShow(true)) yield(); // accessing FS causes glitches due to RMT issue on C3 TODO: remove this when fixed
     #endif
     file = WLED_FS.open(fileName, "r");
 
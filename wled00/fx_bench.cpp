@@ -0,0 +1,295 @@
+#include "wled.h"
+#include "FXparticleSystem.h"
+
+/*
+ * Effect benchmark
+ * Runs every registered effect for a number of frames on a scratch segment of configurable size
+ * and records render time per frame and effect data usage. One effect is benchmarked per loop()
+ * pass so web server and network stay responsive while the suite is running.
+ *
+ * Realtime ingest (per-pixel setRealtimePixel() vs. span setRealtimePixels()) is measured at the end
+ * of the run using a full strip RGB frame. Pixel span kernels (see colors.cpp) are compared with the
+ * per-pixel code they replace for speed and identical output. Column passes (blur2D y pass, moveY) are
+ * compared with per-column traversal on a 128x64 buffer in DRAM and (if available) in PSRAM.
+ *
+ * Start:   {"fxbench":{"w":64,"h":64,"n":100}} (JSON API, optional "fx":[first,last] and "psgrid":true/false to
+ *          select particle system collision detection, "m12":0-4 to set 1D expansion and "m12tab":true/false
+ *          to use precomputed expansion tables)
+ * Results: /json/bench (see tools/fx_bench.py)
+ */
+
+#ifdef WLED_ENABLE_FX_BENCHMARK
+
+#define FX_BENCH_MAX_FRAMES 1000
+#define FX_BENCH_INGEST_FRAMES 50
+#ifndef FX_BENCH_KERNEL_PIXELS
+  #define FX_BENCH_KERNEL_PIXELS 1024 // raise (with FX_BENCH_KERNEL_RUNS) for µs resolution on fast CPUs (native build)
+#endif
+#ifndef FX_BENCH_KERNEL_RUNS
+  #define FX_BENCH_KERNEL_RUNS   20
+#endif
+#define FX_BENCH_KERNELS       6
+#define FX_BENCH_COLS          128
+#define FX_BENCH_ROWS          64
+#define FX_BENCH_COLUMN_RUNS   5
+#define FX_BENCH_ALL_KERNELS   (FX_BENCH_KERNELS + 4) // + blur columns & moveY for DRAM and PSRAM
+
+static WS2812FX::fx_bench_t *benchResults = nullptr; // one entry per effect
+static uint16_t benchWidth  = 0;
+static uint16_t benchHeight = 0;
+static uint16_t benchFrames = 0;
+static uint8_t  benchFirst  = 0;
+static uint8_t  benchLast   = 0;
+static uint8_t  benchM12    = UINT8_MAX; // 1D expansion, UINT8_MAX = effect default
+static int16_t  benchNext   = -1;  // next effect to benchmark, -1 if idle
+static unsigned long benchStart = 0;
+static unsigned long benchTime  = 0;
+static uint32_t benchIngest[2]  = {0, 0}; // average us per frame: per-pixel, span
+static uint32_t benchKernels[FX_BENCH_ALL_KERNELS][3]; // per kernel: per-pixel us, span us, identical output
+static const char benchKernelNames[] PROGMEM = "fill,scale,blend color,fade toward,blur,blend,blur cols DRAM,moveY DRAM,blur cols PSRAM,moveY PSRAM";
+
+// realtime protocols write into the frame buffer, which is overwritten by the next show()
+static void benchmarkIngest()
+{
+  unsigned len = strip.getLengthTotal();
+  uint8_t *frame = static_cast<uint8_t*>(d_malloc(len * 3));
+  if (!frame) return;
+  for (unsigned i = 0; i < len * 3; i++) frame[i] = i;
+
+  unsigned long start = micros();
+  for (unsigned f = 0; f < FX_BENCH_INGEST_FRAMES; f++)
+    for (unsigned i = 0; i < len; i++) setRealtimePixel(i, frame[i*3], frame[i*3+1], frame[i*3+2], 0);
+  benchIngest[0] = (micros() - start) / FX_BENCH_INGEST_FRAMES;
+
+  start = micros();
+  for (unsigned f = 0; f < FX_BENCH_INGEST_FRAMES; f++) setRealtimePixels(0, frame, len);
+  benchIngest[1] = (micros() - start) / FX_BENCH_INGEST_FRAMES;
+
+  d_free(frame);
+}
+
+// per-pixel versions of Segment::fade_out() etc. before they were moved to span kernels
+static void referenceKernel(unsigned k, uint32_t *p, const uint32_t *src, size_t n) {
+  const uint32_t c = 0x40102030;
+  switch (k) {
+    case 0: for (size_t i = 0; i < n; i++) p[i] = c; break;
+    case 1: for (size_t i = 0; i < n; i++) p[i] = fast_color_scale(p[i], 200); break;
+    case 2: for (size_t i = 0; i < n; i++) p[i] = color_blend(p[i], c, 100); break;
+    case 3:
+      for (size_t j = 0; j < n; j++) {
+        uint32_t color = p[j];
+        if (color == c) continue;
+        for (int i = 0; i < 32; i += 8) {
+          uint8_t c2 = (c>>i);
+          uint8_t c1 = (color>>i);
+          int delta = (c2 - c1) * 3 / 256; // fade_out(100)
+          if (delta == 0) delta += (c2 == c1) ? 0 : (c2 > c1) ? 1 : -1;
+          color &= ~(0xFF<<i);
+          color |= ((c1 + delta) & 0xFF) << i;
+        }
+        p[j] = color;
+      }
+      break;
+    case 4: {
+      uint32_t cur = p[0];
+      uint32_t carryover = fast_color_scale(cur, 64);
+      p[0] = fast_color_scale(cur, 127);
+      for (size_t i = 1; i < n; i++) {
+        cur = p[i];
+        uint32_t part = fast_color_scale(cur, 64);
+        cur = color_add(fast_color_scale(cur, 127), carryover);
+        p[i-1] = color_add(p[i-1], part);
+        p[i] = cur;
+        carryover = part;
+      }
+      } break;
+    case 5: for (size_t i = 0; i < n; i++) p[i] = color_blend(p[i], src[i], 180); break;
+  }
+}
+
+static void spanKernel(unsigned k, uint32_t *p, const uint32_t *src, size_t n) {
+  const uint32_t c = 0x40102030;
+  switch (k) {
+    case 0: span_fill(p, n, c); break;
+    case 1: span_scale(p, n, 200); break;
+    case 2: span_blend_color(p, n, c, 100); break;
+    case 3: span_fade_toward(p, n, c, 3); break;
+    case 4: span_blur(p, n, 1, 127, 64); break;
+    case 5: span_blend(p, 1, src, n, 180); break;
+  }
+}
+
+static void benchmarkKernels()
+{
+  const size_t n = FX_BENCH_KERNEL_PIXELS;
+  uint32_t *src = static_cast<uint32_t*>(d_malloc(3 * n * sizeof(uint32_t)));
+  if (!src) return;
+  uint32_t *ref = src + n;
+  uint32_t *dst = src + 2*n;
+  for (size_t i = 0; i < n; i++) src[i] = hw_random();
+  for (unsigned k = 0; k < FX_BENCH_KERNELS; k++) {
+    bool same = true;
+    uint32_t time[2] = {0, 0};
+    for (unsigned r = 0; r < FX_BENCH_KERNEL_RUNS; r++) {
+      memcpy(ref, src, n * sizeof(uint32_t));
+      memcpy(dst, src, n * sizeof(uint32_t));
+      uint32_t start = micros();
+      referenceKernel(k, ref, src, n);
+      time[0] += micros() - start;
+      start = micros();
+      spanKernel(k, dst, src, n);
+      time[1] += micros() - start;
+      same &= memcmp(ref, dst, n * sizeof(uint32_t)) == 0;
+      for (size_t i = 0; i < n; i++) src[i] = src[i] * 1664525UL + 1013904223UL; // new content for next run
+    }
+    benchKernels[k][0] = time[0] / FX_BENCH_KERNEL_RUNS;
+    benchKernels[k][1] = time[1] / FX_BENCH_KERNEL_RUNS;
+    benchKernels[k][2] = same;
+  }
+  d_free(src);
+}
+
+// column passes: k=0 blur2D() y pass, k=1 moveY(3, wrap); reference strides through the buffer one column at a time
+static void referenceColumns(unsigned k, uint32_t *p) {
+  if (k == 0) {
+    for (unsigned col = 0; col < FX_BENCH_COLS; col++) span_blur(&p[col], FX_BENCH_ROWS, FX_BENCH_COLS, 127, 64);
+    return;
+  }
+  uint32_t newPxCol[FX_BENCH_ROWS];
+  for (unsigned x = 0; x < FX_BENCH_COLS; x++) {
+    for (unsigned y = 0; y < FX_BENCH_ROWS; y++) newPxCol[y] = p[x + ((y + 3) % FX_BENCH_ROWS) * FX_BENCH_COLS];
+    for (unsigned y = 0; y < FX_BENCH_ROWS; y++) p[x + y * FX_BENCH_COLS] = newPxCol[y];
+  }
+}
+
+static void benchmarkColumns(uint8_t alloc, unsigned slot) {
+  const size_t n = FX_BENCH_COLS * FX_BENCH_ROWS;
+  uint32_t *ref = static_cast<uint32_t*>(allocate_buffer(2 * n * sizeof(uint32_t), alloc | BFRALLOC_NOBYTEACCESS));
+  if (!ref) return;
+  uint32_t *dst = ref + n;
+  for (unsigned k = 0; k < 2; k++) {
+    bool same = true;
+    uint32_t time[2] = {0, 0};
+    for (unsigned r = 0; r < FX_BENCH_COLUMN_RUNS; r++) {
+      for (size_t i = 0; i < n; i++) ref[i] = dst[i] = hw_random();
+      uint32_t start = micros();
+      referenceColumns(k, ref);
+      time[0] += micros() - start;
+      start = micros();
+      if (k == 0) span_blur_columns(dst, FX_BENCH_COLS, FX_BENCH_ROWS, 127, 64);
+      else        span_move_rows(dst, FX_BENCH_COLS, FX_BENCH_ROWS, 3, true);
+      time[1] += micros() - start;
+      same &= memcmp(ref, dst, n * sizeof(uint32_t)) == 0;
+    }
+    benchKernels[slot + k][0] = time[0] / FX_BENCH_COLUMN_RUNS;
+    benchKernels[slot + k][1] = time[1] / FX_BENCH_COLUMN_RUNS;
+    benchKernels[slot + k][2] = same;
+  }
+  p_free(ref);
+}
+
+// called from deserializeState(); benchmark itself runs from loop()
+void startFxBenchmark(JsonObject bench)
+{
+  unsigned w = bench["w"] | strip.getLengthTotal();
+  unsigned h = bench["h"] | 1;
+  unsigned n = bench["n"] | 100;
+  #ifdef WLED_DISABLE_2D
+  h = 1;
+  #endif
+  if (w == 0 || h == 0 || w * h > MAX_LEDS || n == 0) return;
+
+  d_free(benchResults);
+  benchResults = static_cast<WS2812FX::fx_bench_t*>(d_calloc(strip.getModeCount(), sizeof(WS2812FX::fx_bench_t)));
+  if (!benchResults) {
+    benchNext = -1;
+    errorFlag = ERR_NORAM;
+    return;
+  }
+  benchWidth  = w;
+  benchHeight = h;
+  benchFrames = min(n, (unsigned)FX_BENCH_MAX_FRAMES);
+  benchFirst  = bench["fx"][0] | 0;
+  benchLast   = bench["fx"][1] | (strip.getModeCount() - 1);
+  if (benchLast >= strip.getModeCount()) benchLast = strip.getModeCount() - 1;
+  if (benchFirst > benchLast) benchFirst = benchLast;
+  benchNext   = benchFirst;
+  benchM12    = bench[F("m12")] | UINT8_MAX;
+  #ifndef WLED_DISABLE_2D
+  Segment::useMappingTables = bench[F("m12tab")] | Segment::useMappingTables;
+  #endif
+  #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
+  particleCollisionGrid = bench[F("psgrid")] | particleCollisionGrid;
+  #endif
+  benchStart  = millis();
+  benchTime   = 0;
+  DEBUG_PRINTF_P(PSTR("FX benchmark started: %ux%u, %u frames, FX %u-%u\n"), w, h, benchFrames, benchFirst, benchLast);
+}
+
+void handleFxBenchmark()
+{
+  if (benchNext < 0 || !benchResults) return;
+  strip.benchmarkEffect(benchNext, benchWidth, benchHeight, benchFrames, benchResults[benchNext], benchM12); // reserved effects are left zeroed
+  if (++benchNext > benchLast) {
+    benchNext = -1;
+    benchmarkIngest();
+    benchmarkKernels();
+    benchmarkColumns(BFRALLOC_ENFORCE_DRAM, FX_BENCH_KERNELS);
+    #if defined(BOARD_HAS_PSRAM)
+    if (psramFound()) benchmarkColumns(BFRALLOC_ENFORCE_PSRAM, FX_BENCH_KERNELS + 2);
+    #endif
+    benchTime = millis() - benchStart;
+    DEBUG_PRINTF_P(PSTR("FX benchmark finished in %lums.\n"), benchTime);
+  }
+}
+
+void serializeFxBenchmark(JsonObject root)
+{
+  root["w"]   = benchWidth;
+  root["h"]   = benchHeight;
+  root["n"]   = benchFrames;
+  root["fps"] = strip.getTargetFps();
+  root[F("show")] = strip.getShowTime(); // time spent blending & sending frame to buses (us)
+  JsonArray frames = root.createNestedArray(F("frames")); // since boot: frames blended, unchanged frames sent without blending (damage tracking)
+  frames.add(strip.getFramesShown());
+  frames.add(strip.getFramesSkipped());
+  root[F("2D")] = strip.isMatrix;  // 2D effects fall back to solid on 1D setups
+  if (benchM12 != UINT8_MAX) root[F("m12")] = benchM12;
+  #ifndef WLED_DISABLE_2D
+  root[F("m12tab")] = Segment::useMappingTables;
+  #endif
+  #if !(defined(WLED_DISABLE_PARTICLESYSTEM2D) && defined(WLED_DISABLE_PARTICLESYSTEM1D))
+  root[F("psgrid")] = particleCollisionGrid;
+  #endif
+  root[F("busy")] = benchNext >= 0;
+  root[F("time")] = benchNext >= 0 ? millis() - benchStart : benchTime;
+  JsonArray ingest = root.createNestedArray(F("ingest")); // realtime frame ingest (us): per-pixel, span
+  ingest.add(benchIngest[0]);
+  ingest.add(benchIngest[1]);
+  // pixel span kernels on FX_BENCH_KERNEL_PIXELS pixels: {name: [per-pixel us, span us, identical output]}
+  JsonObject kernels = root.createNestedObject(F("kernels"));
+  char names[sizeof(benchKernelNames)];
+  strcpy_P(names, benchKernelNames);
+  char *name = strtok(names, ",");
+  for (unsigned k = 0; k < FX_BENCH_ALL_KERNELS && name; k++, name = strtok(nullptr, ",")) {
+    if (benchKernels[k][0] == 0 && benchKernels[k][1] == 0) continue; // not measured (no PSRAM or out of memory)
+    JsonArray kr = kernels.createNestedArray(String(name));
+    kr.add(benchKernels[k][0]);
+    kr.add(benchKernels[k][1]);
+    kr.add(bool(benchKernels[k][2]));
+  }
+  if (!benchResults) return;
+  root[F("first")] = benchFirst;
+  // each entry is [avg us, max us, effect data, total segment data]
+  JsonArray fx = root.createNestedArray("fx");
+  unsigned last = benchNext >= 0 ? benchNext : benchLast + 1;
+  for (unsigned i = benchFirst; i < last; i++) {
+    JsonArray r = fx.createNestedArray();
+    r.add(benchResults[i].avgUs);
+    r.add(benchResults[i].maxUs);
+    r.add(benchResults[i].dataLen);
+    r.add(benchResults[i].dataUsed);
+  }
+}
+
+#endif
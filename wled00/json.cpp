@@ -1,4 +1,5 @@
 #include "wled.h"
+#include <StreamString.h>
 
 #define JSON_PATH_STATE      1
 #define JSON_PATH_INFO       2
@@ -310,6 +311,11 @@ static bool deserializeSegment(JsonObject elem, byte it, byte presetId = 0)
   seg.check3 = getBoolVal(elem["o3"], seg.check3);
 
   getVal(elem["bm"], seg.blendMode);
+  // effect frame rate: 0 (strip rate), 1-250 or SEGMENT_FPS_ON_CHANGE
+  if (elem["fps"].is<int>()) {
+    int fps = elem["fps"];
+    if (fps >= 0) seg.fps = fps == SEGMENT_FPS_ON_CHANGE ? fps : min(fps, 250);
+  } else getVal(elem["fps"], seg.fps, 0, 250);
 
   JsonArray iarr = elem[F("i")]; //set individual LEDs
   if (!iarr.isNull()) {
@@ -501,6 +507,11 @@ bool deserializeState(JsonObject root, byte callMode, byte presetId)
 
   loadLedmap = root[F("ledmap")] | loadLedmap;
 
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  JsonObject fxbench = root[F("fxbench")];
+  if (!fxbench.isNull()) startFxBenchmark(fxbench);
+  #endif
+
   byte ps = root[F("psave")];
   if (ps > 0 && ps < 251) savePreset(ps, nullptr, root);
 
@@ -642,9 +653,11 @@ static void serializeSegment(JsonObject& root, const Segment& seg, byte id, bool
   root["si"]  = seg.soundSim;
   root["m12"] = seg.map1D2D;
   root["bm"]  = seg.blendMode;
+  root["fps"] = seg.fps;
 }
 
-void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+// everything in state except "seg" (which is always the last key)
+static void serializeStateNoSegments(JsonObject root, bool forPreset, bool includeBri)
 {
   if (includeBri) {
     root["on"] = (bri > 0);
@@ -679,6 +692,11 @@ void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segme
   }
 
   root[F("mainseg")] = strip.getMainSegmentId();
+}
+
+void serializeState(JsonObject root, bool forPreset, bool includeBri, bool segmentBounds, bool selectedSegmentsOnly)
+{
+  serializeStateNoSegments(root, forPreset, includeBri);
 
   JsonArray seg = root.createNestedArray("seg");
   for (size_t s = 0; s < WS2812FX::getMaxSegments(); s++) {
@@ -739,12 +757,17 @@ void serializeInfo(JsonObject root)
 
   unsigned totalLC = 0;
   JsonArray lcarr = leds.createNestedArray(F("seglc")); // deprecated, use state.seg[].lc
+  JsonArray fpsarr = leds.createNestedArray(F("segfps")); // per active segment: [effect FPS, average render time (us)]
   size_t nSegs = strip.getSegmentsNum();
   for (size_t s = 0; s < nSegs; s++) {
-    if (!strip.getSegment(s).isActive()) continue;
-    unsigned lc = strip.getSegment(s).getLightCapabilities();
+    const Segment &seg = strip.getSegment(s);
+    if (!seg.isActive()) continue;
+    unsigned lc = seg.getLightCapabilities();
     totalLC |= lc;
     lcarr.add(lc); // deprecated, use state.seg[].lc
+    JsonArray sf = fpsarr.createNestedArray();
+    sf.add(seg.getRenderFps());
+    sf.add(seg.getRenderTime());
   }
 
   leds["lc"] = totalLC;
@@ -785,6 +808,11 @@ void serializeInfo(JsonObject root)
   }
 
   root[F("lip")] = realtimeIP[0] == 0 ? "" : realtimeIP.toString();
+  serializeUdpStats(root.createNestedArray(F("udp"))); // UDP packets/s: processed, dropped, coalesced frames; passes/s with packets left over (budget exhausted)
+  JsonArray netOut = root.createNestedArray(F("nout")); // network bus output: avg. send time (us), frames skipped (sender busy)
+  netOut.add(BusNetwork::getSendTime());
+  netOut.add(BusNetwork::getFramesSkipped());
+  serializeJSONBufferStats(root.createNestedObject(F("jbuf"))); // JSON buffer contention
 
   #ifdef WLED_ENABLE_WEBSOCKETS
   root[F("ws")] = ws.count();
@@ -879,6 +907,13 @@ void serializeInfo(JsonObject root)
 #endif
 
   root[F("freeheap")] = getFreeHeapSize();
+  #ifndef WLED_DISABLE_SEGMENT_ARENA
+  JsonObject arena = root.createNestedObject(F("arena")); // segment buffer arena: fragmentation shows as lfb well below size-used
+  arena[F("size")]   = SegmentArena::getSize();
+  arena[F("used")]   = SegmentArena::getUsed();
+  arena[F("lfb")]    = SegmentArena::getLargestFree();
+  arena[F("blocks")] = SegmentArena::getBlocks();
+  #endif
   #if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
   // Report PSRAM information
   // Free PSRAM in bytes (backward compatibility)
@@ -1323,6 +1358,156 @@ void respondModeData(AsyncWebServerRequest* request) {
   });
 }
 
+// Print adapter passing through only the first limit bytes
+class LimitedPrint : public Print {
+  Print &_out;
+  size_t _left;
+  public:
+  LimitedPrint(Print &out, size_t limit) : _out(out), _left(limit) {}
+  size_t write(uint8_t c) override { if (_left) { _left--; _out.write(c); } return 1; }
+  size_t write(const uint8_t *buf, size_t size) override {
+    size_t n = min(size, _left);
+    if (n) _out.write(buf, n);
+    _left -= n;
+    return size;
+  }
+};
+
+/*
+ * Streaming state/info serialization
+ * Output is produced one part at a time (state without segments, each segment, info) using doc as scratch space,
+ * so doc only needs to hold the largest part and JSON buffer usage no longer grows with the number of segments.
+ * Output is byte identical to serializeJson() of the document built by serializeState()/serializeInfo():
+ * state, info or {"state":{...},"info":{...}} if both are requested.
+ * Parts: 0 = opening, 1 = state (without segments), 2..n+1 = segments, then info and closing.
+ * Each part has to be generated while holding the JSON buffer lock (or strip.beginStateRead() when using a pooled
+ * document). If parts are generated separately, output must be discarded if strip.getSuspendCount() changed in
+ * between (segments may have been added or removed).
+ */
+size_t serializeStatePart(Print &out, JsonDocument &doc, bool state, bool info, unsigned &part)
+{
+  const bool both = state && info;
+  const unsigned segStart = 2;
+  const unsigned segEnd   = segStart + (state ? strip.getSegmentsNum() : 0);
+  size_t len = 0;
+  doc.clear();
+  if (part == 0) {
+    if (both) len += out.print(F("{\"state\":"));
+    part = state ? 1 : segEnd;
+    return len;
+  }
+  if (part == 1) {
+    JsonObject root = doc.to<JsonObject>();
+    serializeStateNoSegments(root, false, true);
+    root.createNestedArray("seg"); // "seg":[]} -> "seg":[
+    LimitedPrint lp(out, measureJson(doc) - 2);
+    len += serializeJson(doc, lp) - 2;
+    part = segStart;
+    return len;
+  }
+  // same conditions as serializeState(root) with default options
+  while (part < segEnd && !strip.getSegment(part - segStart).isActive()) part++;
+  if (part < segEnd) {
+    JsonObject seg = doc.to<JsonObject>();
+    unsigned s = part - segStart;
+    bool first = true;
+    for (unsigned i = 0; i < s; i++) if (strip.getSegment(i).isActive()) { first = false; break; }
+    if (!first) len += out.write(',');
+    serializeSegment(seg, strip.getSegment(s), s, false, true);
+    len += serializeJson(doc, out);
+    part++;
+    return len;
+  }
+  if (part == segEnd) {
+    if (state) len += out.print(F("]}"));
+    if (both) len += out.print(F(",\"info\":"));
+    if (info) {
+      serializeInfo(doc.to<JsonObject>());
+      len += serializeJson(doc, out);
+    }
+    if (both) len += out.write('}');
+    part = UINT16_MAX; // done
+  }
+  return len;
+}
+
+// returns JSON_STREAM_OVERFLOW if a part did not fit into doc (output is incomplete and has to be discarded)
+size_t serializeStateStream(Print &out, JsonDocument &doc, bool state, bool info)
+{
+  size_t len = 0;
+  unsigned part = 0;
+  bool overflowed = false;
+  while (part != UINT16_MAX) {
+    len += serializeStatePart(out, doc, state, info, part);
+    overflowed |= doc.overflowed();
+  }
+  return overflowed ? JSON_STREAM_OVERFLOW : len;
+}
+
+/*
+ * State/info response that is generated part by part while it is being sent (see serializeStatePart()), so only one
+ * part is held in memory no matter how many segments there are. Parts are generated using a pooled document (taken for
+ * the whole response) or the global JSON buffer (locked for one part at a time). If segments change while the response
+ * is sent, it is cut short (client gets incomplete JSON and has to request state again).
+ */
+class StateStreamer {
+  JsonDocument *_doc;   // pooled document, nullptr if not available
+  StreamString  _out;   // current part
+  size_t   _sent = 0;   // bytes of current part already sent
+  unsigned _part = 0;
+  uint16_t _suspendCount;
+  bool     _state, _info;
+
+  // returns 1 if next part was generated, 0 if it has to be tried again later, -1 if segments changed
+  int nextPart() {
+    const unsigned part = _part;
+    const byte err = errorFlag; // serializeState() clears errorFlag, restore it if part has to be generated again
+    if (_doc) {
+      if (!strip.beginStateRead()) return 0; // segments are being changed
+      if (_suspendCount == strip.getSuspendCount()) serializeStatePart(_out, *_doc, _state, _info, _part);
+      strip.endStateRead();
+      if (_part == part) return -1;
+      if (!_doc->overflowed()) return 1;
+      _out.remove(0); // part did not fit, use global JSON buffer
+      _part = part;
+      errorFlag = err;
+    }
+    if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) return 0;
+    if (_suspendCount == strip.getSuspendCount()) serializeStatePart(_out, *pDoc, _state, _info, _part);
+    releaseJSONBufferLock();
+    return _part == part ? -1 : 1;
+  }
+
+  public:
+  StateStreamer(bool state, bool info)
+  : _doc(requestJSONDocument(JSON_LOCK_SERVEJSON))
+  , _suspendCount(strip.getSuspendCount())
+  , _state(state)
+  , _info(info)
+  {}
+  ~StateStreamer() { if (_doc) releaseJSONDocument(_doc); }
+
+  // AwsResponseFiller
+  size_t fill(uint8_t *buf, size_t maxLen) {
+    while (_sent >= _out.length()) {
+      if (_part == UINT16_MAX) return 0; // done
+      _out.remove(0);
+      _sent = 0;
+      int res = nextPart();
+      if (res == 0) return RESPONSE_TRY_AGAIN;
+      if (res < 0) {
+        DEBUG_PRINTLN(F("JSON: state changed while sending."));
+        _part = UINT16_MAX;
+        return 0;
+      }
+    }
+    size_t len = min(maxLen, _out.length() - _sent);
+    memcpy(buf, _out.c_str() + _sent, len);
+    _sent += len;
+    return len;
+  }
+};
+
 // Global buffer locking response helper class (to make sure lock is released when AsyncJsonResponse is destroyed)
 class LockedJsonResponse: public AsyncJsonResponse {
   bool _holding_lock;
@@ -1347,10 +1532,139 @@ class LockedJsonResponse: public AsyncJsonResponse {
   virtual ~LockedJsonResponse() { if (_holding_lock) releaseJSONBufferLock(); };
 };
 
+// Print adapter calculating FNV-1a hash of the output
+class HashPrint : public Print {
+  public:
+  uint32_t hash = 2166136261UL;
+  size_t write(uint8_t c) override { hash = (hash ^ c) * 16777619UL; return 1; }
+  size_t write(const uint8_t *buf, size_t size) override { for (size_t i = 0; i < size; i++) write(buf[i]); return size; }
+};
+
+/*
+ * Delta state updates for WebSocket clients that opted in using {"delta":true}
+ * Only top level state/info keys and segments that changed since the previous delta are sent:
+ *   {"v":version,"b":base,"state":{changed keys,"seg":[changed segments,{"id":n,"stop":0} if deleted]},"info":{changed keys}}
+ * Keys that are no longer present (e.g. "error" once it has been reported) are sent once as "key":null.
+ * b is the version the delta applies to, 0 if it contains complete state (first delta or after a reset). Clients that
+ * see a base other than 0 or their last version lost an update and request a resync by sending {"delta":true} again.
+ * Changes are detected by comparing hashes of serialized values so no copy of the previous state is kept.
+ */
+struct DeltaKey {
+  uint32_t key;   // hash of (part, name)
+  uint32_t value; // hash of serialized value
+  char     part;  // 's' state, 'i' info
+  bool     seen;  // present in current delta
+  String   name;  // needed to send null once the key is gone
+};
+static uint32_t deltaVersion = 0;
+static std::vector<DeltaKey> deltaKeys;
+static uint32_t deltaSegs[MAX_NUM_SEGMENTS]; // hash of segment, 0 if not active
+
+// write "key":value of changed keys in root and "key":null of removed keys, first is cleared if anything was written
+static size_t serializeChangedKeys(Print &out, JsonObject root, char part, bool &first)
+{
+  size_t len = 0;
+  for (DeltaKey &e : deltaKeys) if (e.part == part) e.seen = false;
+  for (JsonPair kv : root) {
+    HashPrint key, value;
+    key.write(part);
+    key.print(kv.key().c_str());
+    serializeJson(kv.value(), value);
+    auto it = std::find_if(deltaKeys.begin(), deltaKeys.end(), [&key](const DeltaKey &e) { return e.key == key.hash; });
+    if (it != deltaKeys.end()) {
+      it->seen = true;
+      if (it->value == value.hash) continue; // unchanged
+      it->value = value.hash;
+    } else deltaKeys.push_back({key.hash, value.hash, part, true, kv.key().c_str()});
+    if (!first) len += out.write(',');
+    first = false;
+    len += out.write('"');
+    len += out.print(kv.key().c_str());
+    len += out.print(F("\":"));
+    len += serializeJson(kv.value(), out);
+  }
+  for (auto it = deltaKeys.begin(); it != deltaKeys.end();) {
+    if (it->part != part || it->seen) { ++it; continue; }
+    if (!first) len += out.write(',');
+    first = false;
+    len += out.write('"');
+    len += out.print(it->name);
+    len += out.print(F("\":null"));
+    it = deltaKeys.erase(it);
+  }
+  return len;
+}
+
+// forget previous state, next delta will contain complete state
+static void resetStateDelta()
+{
+  deltaKeys.clear();
+  memset(deltaSegs, 0, sizeof(deltaSegs));
+}
+
+// writes delta to out using doc as scratch space, returns 0 if nothing changed (output must be discarded)
+// or JSON_STREAM_OVERFLOW if doc was too small (output must be discarded, next delta contains complete state,
+// errorFlag has to be restored by the caller as serializeState() clears it)
+// reset: forget previous state, delta will contain complete state
+size_t serializeStateDelta(Print &out, JsonDocument &doc, bool reset)
+{
+  if (reset) resetStateDelta();
+  const uint32_t base = deltaKeys.empty() ? 0 : deltaVersion;
+  uint32_t version = deltaVersion + 1;
+  if (version == 0) version = 1; // 0 is reserved for "complete state"
+  size_t len = out.printf_P(PSTR("{\"v\":%u,\"b\":%u,\"state\":{"), (unsigned)version, (unsigned)base);
+  size_t changes = 0;
+
+  bool first = true;
+  doc.clear();
+  JsonObject root = doc.to<JsonObject>();
+  serializeStateNoSegments(root, false, true);
+  if (doc.overflowed()) { resetStateDelta(); return JSON_STREAM_OVERFLOW; }
+  changes += serializeChangedKeys(out, root, 's', first);
+
+  bool firstSeg = true;
+  for (unsigned s = 0; s < WS2812FX::getMaxSegments(); s++) {
+    bool active = s < strip.getSegmentsNum() && strip.getSegment(s).isActive();
+    uint32_t hash = 0;
+    if (active) {
+      doc.clear();
+      JsonObject seg = doc.to<JsonObject>();
+      serializeSegment(seg, strip.getSegment(s), s, false, true);
+      if (doc.overflowed()) { resetStateDelta(); return JSON_STREAM_OVERFLOW; }
+      HashPrint hp;
+      serializeJson(doc, hp);
+      hash = hp.hash | 1; // never 0
+    }
+    if (hash == deltaSegs[s]) continue;
+    deltaSegs[s] = hash;
+    if (firstSeg) {
+      if (!first) len += out.write(',');
+      len += out.print(F("\"seg\":["));
+      first = firstSeg = false;
+    } else len += out.write(',');
+    if (active) changes += serializeJson(doc, out);
+    else        changes += out.printf_P(PSTR("{\"id\":%u,\"stop\":0}"), s);
+  }
+  if (!firstSeg) len += out.write(']');
+
+  len += out.print(F("},\"info\":{"));
+  first = true;
+  doc.clear();
+  root = doc.to<JsonObject>();
+  serializeInfo(root);
+  if (doc.overflowed()) { resetStateDelta(); return JSON_STREAM_OVERFLOW; }
+  changes += serializeChangedKeys(out, root, 'i', first);
+  len += out.print(F("}}"));
+
+  if (!changes) return 0;
+  deltaVersion = version;
+  return len + changes;
+}
+
 void serveJson(AsyncWebServerRequest* request)
 {
   enum class json_target {
-    all, state, info, state_info, nodes, effects, palettes, networks, config, pins
+    all, state, info, state_info, nodes, effects, palettes, networks, config, pins, bench
   };
   json_target subJson = json_target::all;
 
@@ -1365,6 +1679,9 @@ void serveJson(AsyncWebServerRequest* request)
   else if (url.indexOf(F("net"))   > 0) subJson = json_target::networks;
   else if (url.indexOf(F("cfg"))   > 0) subJson = json_target::config;
   else if (url.indexOf(F("pins"))  > 0) subJson = json_target::pins;
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  else if (url.indexOf(F("bench")) > 0) subJson = json_target::bench;
+  #endif
   #ifdef WLED_ENABLE_JSONLIVE
   else if (url.indexOf("live")     > 0) {
     serveLiveLeds(request);
@@ -1380,6 +1697,15 @@ void serveJson(AsyncWebServerRequest* request)
     return;
   }
 
+  if (subJson == json_target::state || subJson == json_target::info || subJson == json_target::state_info) {
+    // generated part by part while sending, memory use does not grow with the number of segments
+    auto streamer = std::make_shared<StateStreamer>(subJson != json_target::info, subJson != json_target::state);
+    request->send(request->beginChunkedResponse(FPSTR(CONTENT_TYPE_JSON), [streamer](uint8_t *buf, size_t maxLen, size_t index) {
+      return streamer->fill(buf, maxLen);
+    }));
+    return;
+  }
+
   if (!requestJSONBufferLock(JSON_LOCK_SERVEJSON)) {
     request->deferResponse();    
     return;
@@ -1408,6 +1734,10 @@ void serveJson(AsyncWebServerRequest* request)
       serializeConfig(lDoc); break;
     case json_target::pins:
       serializePins(lDoc); break;
+    #ifdef WLED_ENABLE_FX_BENCHMARK
+    case json_target::bench:
+      serializeFxBenchmark(lDoc); break;
+    #endif
     case json_target::state_info:
     case json_target::all:
       JsonObject state = lDoc.createNestedObject("state");
@@ -49,6 +49,7 @@ void unloadPlaylist() {
   }
   currentPlaylist = playlistIndex = -1;
   playlistLen = 0;
+  clearPresetCache();
   playlistOptions = 0;
   playlistEntryDur = 0;
   DEBUG_PRINTLN(F("Playlist unloaded."));
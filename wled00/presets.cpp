@@ -10,6 +10,7 @@ static char *tmpRAMbuffer = nullptr;
 
 static volatile byte presetToApply = 0;
 static volatile byte callModeToApply = 0;
+static volatile bool presetFromPlaylist = false;
 static volatile byte presetToSave = 0;
 static volatile int8_t saveLedmap = -1;
 static char *quickLoad = nullptr;
@@ -26,6 +27,79 @@ bool presetNeedsSaving() {
   return presetToSave;
 }
 
+/*
+ * Playlist preset cache
+ * Presets applied by the active playlist are kept in RAM in MessagePack form (compact binary representation of the
+ * parsed preset). Stepping through the playlist then does not access the filesystem (no waiting for the strip to
+ * finish sending) and MessagePack is considerably cheaper to parse than JSON text.
+ * Cache is dropped when the playlist is unloaded or presets are modified.
+ */
+#ifdef ESP8266
+#define PRESET_CACHE_ENTRIES 16
+#define PRESET_CACHE_MAX     4096  // total cache size in bytes
+#else
+#define PRESET_CACHE_ENTRIES 32
+#define PRESET_CACHE_MAX     32768
+#endif
+
+typedef struct {
+  uint8_t  id;
+  uint16_t len;
+  uint8_t *data;
+} preset_cache_t;
+
+static preset_cache_t presetCache[PRESET_CACHE_ENTRIES];
+static size_t         presetCacheSize = 0;
+static unsigned long  presetCacheTime = 0;   // presetsModifiedTime when cache was filled
+
+static void evictCachedPreset(preset_cache_t &c) {
+  if (c.data) presetCacheSize -= c.len;
+  p_free(c.data);
+  c.data = nullptr;
+  c.id = 0;
+}
+
+void clearPresetCache() {
+  for (auto &c : presetCache) evictCachedPreset(c);
+  presetCacheSize = 0;
+}
+
+// fill pDoc with cached preset, returns false if preset is not cached
+static bool loadCachedPreset(byte index) {
+  if (presetCacheTime != presetsModifiedTime) {
+    clearPresetCache(); // presets.json was modified (upload, editor)
+    return false;
+  }
+  for (auto &c : presetCache) {
+    if (c.id != index || !c.data) continue;
+    // data is const: ArduinoJson copies strings so cache entry can be freed while pDoc is in use
+    if (deserializeMsgPack(*pDoc, static_cast<const uint8_t*>(c.data), c.len) == DeserializationError::Ok) return true;
+    DEBUG_PRINTF_P(PSTR("Cached preset %u unreadable, evicted.\n"), (unsigned)index);
+    evictCachedPreset(c); // preset is read from file and cached again
+    return false;
+  }
+  return false;
+}
+
+// store preset currently held in pDoc (must be called before deserializeState() modifies it), replaces cached copy of same preset
+static void cachePreset(byte index) {
+  for (auto &c : presetCache) if (c.data && c.id == index) evictCachedPreset(c);
+  size_t len = measureMsgPack(*pDoc);
+  if (len > UINT16_MAX || presetCacheSize + len > PRESET_CACHE_MAX) return;
+  for (auto &c : presetCache) {
+    if (c.data) continue;
+    c.data = static_cast<uint8_t*>(p_malloc(len));
+    if (!c.data) return;
+    serializeMsgPack(*pDoc, c.data, len);
+    c.id  = index;
+    c.len = len;
+    presetCacheSize += len;
+    presetCacheTime  = presetsModifiedTime;
+    DEBUG_PRINTF_P(PSTR("Preset %u cached (%u bytes).\n"), (unsigned)index, len);
+    return;
+  }
+}
+
 static void doSaveState() {
   bool persist = (presetToSave < 251);
 
@@ -70,7 +144,10 @@ static void doSaveState() {
   #endif
   writeObjectToFileUsingId(getPresetsFileName(persist), presetToSave, pDoc);
 
-  if (persist) presetsModifiedTime = toki.second(); //unix time
+  if (persist) {
+    presetsModifiedTime = toki.second(); //unix time
+    clearPresetCache();
+  }
   releaseJSONBufferLock();
   updateFSInfo();
 
@@ -121,6 +198,7 @@ bool applyPresetFromPlaylist(byte index)
   DEBUG_PRINTF_P(PSTR("Request to apply preset: %d\n"), index);
   presetToApply = index;
   callModeToApply = CALL_MODE_DIRECT_CHANGE;
+  presetFromPlaylist = true;
   return true;
 }
 
@@ -130,6 +208,7 @@ bool applyPreset(byte index, byte callMode)
   DEBUG_PRINTF_P(PSTR("Request to apply preset: %u\n"), index);
   presetToApply = index;
   callModeToApply = callMode;
+  presetFromPlaylist = false;
   return true;
 }
 
@@ -157,26 +236,33 @@ void handlePresets()
   bool changePreset = false;
   uint8_t tmpPreset = presetToApply; // store temporary since deserializeState() may call applyPreset()
   uint8_t tmpMode   = callModeToApply;
+  bool fromPlaylist = presetFromPlaylist && tmpPreset < 255;
 
   JsonObject fdo;
 
   presetToApply = 0; //clear request for preset
   callModeToApply = 0;
+  presetFromPlaylist = false;
 
   DEBUG_PRINTF_P(PSTR("Applying preset: %u\n"), (unsigned)tmpPreset);
 
-  #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
-  unsigned long maxWait = millis() + strip.getFrameTime();
-  while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
-  #endif
-
-  #ifdef ARDUINO_ARCH_ESP32
-  if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
-    deserializeJson(*pDoc,tmpRAMbuffer);
-  } else
-  #endif
-  {
-  presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+  if (fromPlaylist && loadCachedPreset(tmpPreset)) {
+    presetErrFlag = ERR_NONE; // cached presets were read without error
+  } else {
+    #if defined(ARDUINO_ARCH_ESP32S2) || defined(ARDUINO_ARCH_ESP32C3)
+    unsigned long maxWait = millis() + strip.getFrameTime();
+    while (strip.isUpdating() && millis() < maxWait) delay(1); // wait for strip to finish updating, accessing FS during sendout causes glitches
+    #endif
+
+    #ifdef ARDUINO_ARCH_ESP32
+    if (tmpPreset==255 && tmpRAMbuffer!=nullptr) {
+      deserializeJson(*pDoc,tmpRAMbuffer);
+    } else
+    #endif
+    {
+    presetErrFlag = readObjectFromFileUsingId(getPresetsFileName(tmpPreset < 255), tmpPreset, pDoc) ? ERR_NONE : ERR_FS_PLOAD;
+    }
+    if (fromPlaylist && presetErrFlag == ERR_NONE) cachePreset(tmpPreset);
   }
   fdo = pDoc->as<JsonObject>();
 
@@ -262,6 +348,7 @@ void savePreset(byte index, const char* pname, JsonObject sObj)
         initPresetsFile(); // just in case if someone deleted presets.json using /edit
         writeObjectToFileUsingId(getPresetsFileName(), index, pDoc);
         presetsModifiedTime = toki.second(); //unix time
+        clearPresetCache();
         updateFSInfo();
       }
       p_free(saveName);
@@ -281,5 +368,6 @@ void deletePreset(byte index) {
   StaticJsonDocument<24> empty;
   writeObjectToFileUsingId(getPresetsFileName(), index, &empty);
   presetsModifiedTime = toki.second(); //unix time
+  clearPresetCache();
   updateFSInfo();
 }
\ No newline at end of file
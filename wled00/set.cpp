@@ -232,6 +232,9 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max mA
       char ld[4] = "LD"; ld[2] = offset+s; ld[3] = 0; //driver type (RMT=0, I2S=1)
       char hs[4] = "HS"; hs[2] = offset+s; hs[3] = 0; //hostname (for network types, custom text for others)
+      char eu[4] = "EU"; eu[2] = offset+s; eu[3] = 0; //E1.31 universe
+      char ep[4] = "EP"; ep[2] = offset+s; ep[3] = 0; //E1.31 priority
+      char es[4] = "ES"; es[2] = offset+s; es[3] = 0; //E1.31 sync universe
       if (!request->hasArg(lp)) {
         DEBUG_PRINTF_P(PSTR("# of buses: %d\n"), s);
         break;
@@ -287,6 +290,11 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
       // actual finalization is done in WLED::loop() (removing old busses and adding new)
       // this may happen even before this loop is finished so we do "doInitBusses" after the loop
       busConfigs.emplace_back(type, pins, start, length, colorOrder | (channelSwap<<4), request->hasArg(cv), skip, awmode, freq, maPerLed, maMax, driverType, text);
+      if ((type & 0x7F) == TYPE_NET_E131_RGB) {
+        if (request->hasArg(eu)) busConfigs.back().universe     = request->arg(eu).toInt();
+        if (request->hasArg(ep)) busConfigs.back().priority     = request->arg(ep).toInt();
+        if (request->hasArg(es)) busConfigs.back().syncUniverse = request->arg(es).toInt();
+      }
       busesChanged = true;
     }
     //doInitBusses = busesChanged; // we will do that below to ensure all input data is processed
@@ -421,6 +429,10 @@ void handleSettingsSet(AsyncWebServerRequest *request, byte subPage)
     if (t >= 0 && t < 4) paletteBlend = t;
     t = request->arg(F("BF")).toInt();
     if (t > 0) briMultiplier = t;
+    if (request->hasArg(F("PG")) != particleCollisionGrid) {
+      particleCollisionGrid = !particleCollisionGrid;
+      strip.restartRuntime(); // particle systems reserve grid memory when created
+    }
 
     doInitBusses = busesChanged;
   }
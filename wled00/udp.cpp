@@ -9,6 +9,12 @@
 static constexpr size_t WLEDPACKETSIZE = 41+(WS2812FX::getMaxSegments()*UDP_SEG_SIZE);  // make sure this is known at compile-time
 #define UDP_IN_MAXSIZE 1472
 #define PRESUMED_NETWORK_DELAY 3 //how many ms could it take on avg to reach the receiver? This will be added to transmitted times
+#ifndef UDP_DRAIN_MAX_PACKETS
+  #define UDP_DRAIN_MAX_PACKETS 24 // max. UDP packets processed per loop() pass (1 to process one packet per pass)
+#endif
+#ifndef UDP_DRAIN_MAX_TIME
+  #define UDP_DRAIN_MAX_TIME 8     // max. time (ms) spent processing UDP packets per loop() pass
+#endif
 
 typedef struct PartialEspNowPacket {
   uint8_t magic;
@@ -17,6 +23,23 @@ typedef struct PartialEspNowPacket {
   uint8_t data[247];
 } partial_packet_t;
 
+// UDP receive statistics (counters are reset every second, *Ps hold values of the last full second)
+// deferred: loop() passes that ran out of packet/time budget, remaining packets wait in the socket queue for the next pass
+// (if that queue overflows lwIP discards packets without WLED noticing, a high count means the budget is too small)
+static struct {
+  uint16_t processed, dropped, coalesced, deferred;
+  uint16_t processedPs, droppedPs, coalescedPs, deferredPs;
+  unsigned long lastUpdate;
+} udpStats = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+static unsigned realtimeShowRequests = 0; // realtime frames received during current drain pass
+
+// realtime packet completed a frame, it will be shown after all pending packets were processed
+static inline void requestRealtimeShow()
+{
+  realtimeShowRequests++;
+}
+
 void notify(byte callMode, bool followUp)
 {
 #ifndef WLED_DISABLE_ESPNOW
@@ -463,28 +486,10 @@ static void sendTPM2Ack() {
 }
 
 
-void handleNotifications()
+// process one pending UDP packet (sync notifier, realtime, hyperion), returns false if none was available
+static bool handleUdpPacket()
 {
   IPAddress localIP;
-
-  //send second notification if enabled
-  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
-    notify(notificationSentCallMode,true);
-  }
-
-  if (e131NewData && millis() - strip.getLastShow() > 15)
-  {
-    e131NewData = false;
-    if (useMainSegmentOnly) strip.trigger();
-    else                    strip.show();
-  }
-
-  //unlock strip when realtime UDP times out
-  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
-
-  //receive UDP notifications
-  if (!udpConnected) return;
-
   bool isSupp = false;
   size_t packetSize = notifierUdp.parsePacket();
   if (!packetSize && udp2Connected) {
@@ -496,28 +501,24 @@ void handleNotifications()
   if (!packetSize && udpRgbConnected) {
     packetSize = rgbUdp.parsePacket();
     if (packetSize) {
-      if (!receiveDirect) return;
-      if (packetSize > UDP_IN_MAXSIZE || packetSize < 3) return;  // packetSize must not exceed buffersize (UDP_IN_MAXSIZE)
+      if (!receiveDirect || packetSize > UDP_IN_MAXSIZE || packetSize < 3) { udpStats.dropped++; return true; }  // packetSize must not exceed buffersize (UDP_IN_MAXSIZE)
       realtimeIP = rgbUdp.remoteIP();
       DEBUG_PRINTLN(rgbUdp.remoteIP());
       uint8_t lbuf[packetSize];
       rgbUdp.read(lbuf, packetSize);
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_HYPERION);
-      if (realtimeOverride) return;
-      unsigned totalLen = strip.getLengthTotal();
-      for (size_t i = 0, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, lbuf[i], lbuf[i+1], lbuf[i+2], 0);
-      }
-      if (useMainSegmentOnly) strip.trigger();
-      else                    strip.show();
-      return;
+      if (realtimeOverride) { udpStats.dropped++; return true; }
+      setRealtimePixels(0, lbuf, packetSize / 3);
+      requestRealtimeShow();
+      return true;
     }
   }
 
   localIP = WLEDNetwork.localIP();
   //notifier and UDP realtime
-  if (!packetSize || packetSize > UDP_IN_MAXSIZE) return;
-  if (!isSupp && notifierUdp.remoteIP() == localIP) return; //don't process broadcasts we send ourselves
+  if (!packetSize) return false;
+  if (packetSize > UDP_IN_MAXSIZE) { udpStats.dropped++; return true; }
+  if (!isSupp && notifierUdp.remoteIP() == localIP) return true; //don't process broadcasts we send ourselves
 
   uint8_t udpIn[packetSize +1];
   unsigned len;
@@ -526,7 +527,7 @@ void handleNotifications()
 
   // WLED nodes info notifications
   if (isSupp && udpIn[0] == 255 && udpIn[1] == 1 && len >= 40) {
-    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return;
+    if (!nodeListEnabled || notifier2Udp.remoteIP() == localIP) return true;
 
     unsigned unit = udpIn[39];
     NodesMap::iterator it = Nodes.find(unit);
@@ -552,7 +553,7 @@ void handleNotifications()
           build |= udpIn[40+i]<<(8*i);
       it->second.build = build;
     }
-    return;
+    return true;
   }
 
   //wled notifier, ignore if realtime packets active
@@ -560,7 +561,7 @@ void handleNotifications()
   {
     DEBUG_PRINTF_P(PSTR("UDP notification from: %d.%d.%d.%d\n"), notifierUdp.remoteIP()[0], notifierUdp.remoteIP()[1], notifierUdp.remoteIP()[2], notifierUdp.remoteIP()[3]);
     parseNotifyPacket(udpIn);
-    return;
+    return true;
   }
 
   if (receiveDirect) {
@@ -570,13 +571,13 @@ void handleNotifications()
       //if the number of LEDs in your installation doesn't allow that, please include padding bytes at the end of the last packet
       byte tpmType = udpIn[1];
       if (tpmType == 0xaa) { //TPM2.NET polling, expect answer
-        sendTPM2Ack(); return;
+        sendTPM2Ack(); return true;
       }
-      if (tpmType != 0xda) return; //return if notTPM2.NET data
+      if (tpmType != 0xda) return true; //return if notTPM2.NET data
 
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       realtimeLock(realtimeTimeoutMs, REALTIME_MODE_TPM2NET);
-      if (realtimeOverride) return;
+      if (realtimeOverride) { udpStats.dropped++; return true; }
 
       tpmPacketCount++; //increment the packet count
       if (tpmPacketCount == 1) tpmPayloadFrameSize = (udpIn[2] << 8) + udpIn[3]; //save frame size for the whole payload if this is the first packet
@@ -584,62 +585,47 @@ void handleNotifications()
       byte numPackets = udpIn[5];
 
       unsigned id = (tpmPayloadFrameSize/3)*(packetNum-1); //start LED
-      unsigned totalLen = strip.getLengthTotal();
-      // Clamp to prevent buffer overread: loop accesses up to udpIn[tpmPayloadFrameSize + 5]
+      // Clamp to prevent buffer overread: pixel data is read up to udpIn[currentPayloadFrameSize + 5]
       size_t currentPayloadFrameSize = (packetSize >= 5) ? min(tpmPayloadFrameSize, uint16_t(packetSize - 5)) : 0;
-      for (size_t i = 6; i < currentPayloadFrameSize + 4U && id < totalLen; i += 3, id++) {
-        setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-      }
+      setRealtimePixels(id, &udpIn[6], currentPayloadFrameSize / 3);
       if (tpmPacketCount == numPackets) { //reset packet count and show if all packets were received
         tpmPacketCount = 0;
-        if (useMainSegmentOnly) strip.trigger();
-        else                    strip.show();
+        requestRealtimeShow();
       }
-      return;
+      return true;
     }
 
     //UDP realtime: 1 warls 2 drgb 3 drgbw 4 dnrgb 5 dnrgbw
     if (udpIn[0] > 0 && udpIn[0] < 6) {
       realtimeIP = (isSupp) ? notifier2Udp.remoteIP() : notifierUdp.remoteIP();
       DEBUG_PRINTLN(realtimeIP);
-      if (packetSize < 2) return;
+      if (packetSize < 2) return true;
 
       if (udpIn[1] == 0) {
         realtimeTimeout = 0; // cancel realtime mode immediately
-        return;
+        return true;
       } else {
         realtimeLock(udpIn[1]*1000 +1, REALTIME_MODE_UDP);
       }
-      if (realtimeOverride) return;
+      if (realtimeOverride) { udpStats.dropped++; return true; }
 
-      unsigned totalLen = strip.getLengthTotal();
       if (udpIn[0] == 1 && packetSize > 5) { //warls
         for (size_t i = 2; i < packetSize -3; i += 4) {
           setRealtimePixel(udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3], 0);
         }
       } else if (udpIn[0] == 2 && packetSize > 4) { //drgb
-        for (size_t i = 2, id = 0; i < packetSize -2 && id < totalLen; i += 3, id++)
-          {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-          }
+        setRealtimePixels(0, &udpIn[2], (packetSize - 2) / 3, 3);
       } else if (udpIn[0] == 3 && packetSize > 6) { //drgbw
-          for (size_t i = 2, id = 0; i < packetSize -3 && id < totalLen; i += 4, id++) {
-            setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-          }
+        setRealtimePixels(0, &udpIn[2], (packetSize - 2) / 4, 4);
       } else if (udpIn[0] == 4 && packetSize > 7) { //dnrgb
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 3, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], 0);
-        }
+        setRealtimePixels(id, &udpIn[4], (packetSize - 4) / 3, 3);
       } else if (udpIn[0] == 5 && packetSize > 8) { //dnrgbw
         unsigned id = ((udpIn[3] << 0) & 0xFF) + ((udpIn[2] << 8) & 0xFF00);
-        for (size_t i = 4; i < packetSize -2 && id < totalLen; i += 4, id++) {
-          setRealtimePixel(id, udpIn[i], udpIn[i+1], udpIn[i+2], udpIn[i+3]);
-        }
+        setRealtimePixels(id, &udpIn[4], (packetSize - 4) / 4, 4);
       }
-      if (useMainSegmentOnly) strip.trigger();
-      else                    strip.show();
-      return;
+      requestRealtimeShow();
+      return true;
     }
   }
 
@@ -660,6 +646,65 @@ void handleNotifications()
   }
 
   UsermodManager::onUdpPacket(udpIn, packetSize);
+  return true;
+}
+
+void handleNotifications()
+{
+  //send second notification if enabled
+  if(udpConnected && (notificationCount < udpNumRetries) && ((millis()-notificationSentTime) > 250)){
+    notify(notificationSentCallMode,true);
+  }
+
+  if (e131NewData && millis() - strip.getLastShow() > 15)
+  {
+    e131NewData = false;
+    if (useMainSegmentOnly) strip.trigger();
+    else                    strip.show();
+  }
+
+  //unlock strip when realtime UDP times out
+  if (realtimeMode && millis() > realtimeTimeout) exitRealtime();
+
+  //receive UDP notifications
+  if (!udpConnected) return;
+
+  // drain all pending packets (within budget) so that multi-packet realtime frames are applied in one pass
+  // realtime packets only request an update, the frame is shown once after the last packet was processed
+  unsigned long drainStart = millis();
+  unsigned packets = 0;
+  bool budgetExhausted = true;
+  while (packets < UDP_DRAIN_MAX_PACKETS) {
+    if (!handleUdpPacket()) { budgetExhausted = false; break; } // nothing pending
+    packets++;
+    if (millis() - drainStart >= UDP_DRAIN_MAX_TIME) break;
+  }
+  udpStats.processed += packets;
+  if (budgetExhausted) udpStats.deferred++;
+
+  if (realtimeShowRequests) {
+    udpStats.coalesced += realtimeShowRequests - 1;
+    realtimeShowRequests = 0;
+    if (useMainSegmentOnly) strip.trigger();
+    else                    strip.show();
+  }
+
+  if (millis() - udpStats.lastUpdate >= 1000) {
+    udpStats.lastUpdate = millis();
+    udpStats.processedPs = udpStats.processed; udpStats.processed = 0;
+    udpStats.droppedPs   = udpStats.dropped;   udpStats.dropped   = 0;
+    udpStats.coalescedPs = udpStats.coalesced; udpStats.coalesced = 0;
+    udpStats.deferredPs  = udpStats.deferred;  udpStats.deferred  = 0;
+    if (udpStats.deferredPs) DEBUG_PRINTF_P(PSTR("UDP: %u packets/s, budget exhausted in %u passes/s\n"), udpStats.processedPs, udpStats.deferredPs);
+  }
+}
+
+void serializeUdpStats(JsonArray stats)
+{
+  stats.add(udpStats.processedPs);
+  stats.add(udpStats.droppedPs);
+  stats.add(udpStats.coalescedPs);
+  stats.add(udpStats.deferredPs);
 }
 
 
@@ -669,6 +714,19 @@ void setRealtimePixel(uint16_t i, byte r, byte g, byte b, byte w)
   strip.setRealtimePixelColor(pix, RGBW32(r,g,b,w));
 }
 
+// set count pixels starting at i from packed RGB (channels=3) or RGBW (channels=4) data
+void setRealtimePixels(uint16_t i, const uint8_t *data, unsigned count, unsigned channels)
+{
+  int pix = i + arlsOffset;
+  if (pix < 0) { // skip pixels shifted before strip start
+    if (unsigned(-pix) >= count) return;
+    data  += unsigned(-pix) * channels;
+    count -= unsigned(-pix);
+    pix = 0;
+  }
+  strip.setRealtimePixelColors(pix, data, count, channels);
+}
+
 /*********************************************************************************************\
    Refresh aging for remote units, drop if too old...
 \*********************************************************************************************/
@@ -747,15 +805,58 @@ void sendSysInfoUDP()
 // length - the number of pixels
 // buffer - a buffer of at least length*4 bytes long
 // isRGBW - true if the buffer contains 4 components per pixel
+// packet - packet buffer of at least realtimeBroadcastBufferSize() bytes, each packet is assembled in it and sent with a single write
+// universe, priority, syncUniverse - E1.31 only: first universe, source priority and synchronization universe (0 = no sync packets)
 
 static       size_t sequenceNumber = 0; // this needs to be shared across all outputs
 static const size_t ART_NET_HEADER_SIZE = 12;
 static const byte   ART_NET_HEADER[] PROGMEM = {0x41,0x72,0x74,0x2d,0x4e,0x65,0x74,0x00,0x00,0x50,0x00,0x0e};
+static const size_t ART_NET_DMX_HEADER_SIZE = ART_NET_HEADER_SIZE + 6; // ID, OpCode & version followed by sequence, physical, universe and length
+static const byte   E131_ACN_ID[] PROGMEM = {0x41,0x53,0x43,0x2d,0x45,0x31,0x2e,0x31,0x37,0x00,0x00,0x00}; // "ASC-E1.17"
+static const size_t E131_HEADER_SIZE = E131_DMP_DATA + 1; // root, framing and DMP layer incl. DMX start code
+static const size_t E131_SYNC_SIZE = 49;
+
+static WiFiUDP broadcastUdp; // reused for all outputs and frames (creating a socket per frame is expensive)
+
+// copy channel data into packet applying brightness
+static void scaleChannels(uint8_t *dst, const uint8_t *src, size_t len, uint8_t bri) {
+  if (bri == 255) memcpy(dst, src, len);
+  else for (size_t i = 0; i < len; i++) dst[i] = scale8(src[i], bri);
+}
 
-uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t bri, bool isRGBW)  {
-  if (!(apActive || interfacesInited) || !client[0] || !length) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
+// fill fields of E1.31 data packet that do not change between packets and frames
+static void initE131Header(e131_packet_t *p) {
+  memset(p->raw, 0, E131_HEADER_SIZE);
+  p->preamble_size = htons(0x0010);
+  memcpy_P(p->acn_id, E131_ACN_ID, sizeof(p->acn_id));
+  p->root_vector = htonl(0x00000004); // VECTOR_ROOT_E131_DATA
+  memcpy_P(p->cid, PSTR("WLED"), 4);  // component identifier: unique per device
+  memcpy(p->cid + 4, escapedMac.c_str(), min(escapedMac.length(), sizeof(p->cid) - 4));
+  p->frame_vector = htonl(0x00000002); // VECTOR_E131_DATA_PACKET
+  strlcpy(reinterpret_cast<char*>(p->source_name), serverDescription, sizeof(p->source_name));
+  p->dmp_vector = 0x02;   // VECTOR_DMP_SET_PROPERTY
+  p->type = 0xa1;
+  p->address_increment = htons(1);
+}
 
-  WiFiUDP ddpUdp;
+// E1.31 destination: multicast group of the universe if a multicast address was configured, configured address otherwise
+static IPAddress e131Destination(IPAddress client, uint16_t universe) {
+  if (client[0] >= 224 && client[0] <= 239) return IPAddress(239, 255, universe >> 8, universe & 0xFF);
+  return client;
+}
+
+// returns size of packet buffer required by realtimeBroadcast() for given protocol and number of channels
+size_t realtimeBroadcastBufferSize(uint8_t type, size_t channelCount) {
+  switch (type) {
+    case 0:  return DDP_HEADER_LEN + min(channelCount, size_t(DDP_CHANNELS_PER_PACKET));
+    case 1:  return E131_HEADER_SIZE + min(channelCount, size_t(512));
+    case 2:  return ART_NET_DMX_HEADER_SIZE + min(channelCount, size_t(512));
+    default: return 0;
+  }
+}
+
+uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const uint8_t *buffer, uint8_t *packet, uint8_t bri, bool isRGBW, uint16_t universe, uint8_t priority, uint16_t syncUniverse)  {
+  if (!(apActive || interfacesInited) || !client[0] || !length || !packet) return 1;  // network not initialised or dummy/unset IP address  031522 ajn added check for ap
 
   switch (type) {
     case 0: // DDP
@@ -769,14 +870,13 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
       // the current position in the buffer
       size_t bufferOffset = 0;
 
+      // header fields that do not change between packets
+      packet[2] = isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24;
+      packet[3] = DDP_ID_DISPLAY;
+
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
         if (sequenceNumber > 15) sequenceNumber = 0;
 
-        if (!ddpUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
-          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
-          return 1; // problem
-        }
-
         // the amount of data is AFTER the header in the current packet
         size_t packetSize = DDP_CHANNELS_PER_PACKET;
 
@@ -791,30 +891,28 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
         }
 
         // write the header
-        /*0*/ddpUdp.write(flags);
+        packet[0] = flags;
         // TODO: sequence number should be 1-15 as 0 means "unused", it has no bad consequences other than out of sequence packet may be accepted
-        /*1*/ddpUdp.write(sequenceNumber++ & 0x0F); // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
-        /*2*/ddpUdp.write(isRGBW ?  DDP_TYPE_RGBW32 : DDP_TYPE_RGB24);
-        /*3*/ddpUdp.write(DDP_ID_DISPLAY);
+        packet[1] = sequenceNumber++ & 0x0F; // sequence may be unnecessary unless we are sending twice (as requested in Sync settings)
         // data offset in bytes, 32-bit number, MSB first
-        /*4*/ddpUdp.write(0xFF & (channel >> 24));
-        /*5*/ddpUdp.write(0xFF & (channel >> 16));
-        /*6*/ddpUdp.write(0xFF & (channel >>  8));
-        /*7*/ddpUdp.write(0xFF & (channel      ));
+        packet[4] = 0xFF & (channel >> 24);
+        packet[5] = 0xFF & (channel >> 16);
+        packet[6] = 0xFF & (channel >>  8);
+        packet[7] = 0xFF & (channel      );
         // data length in bytes, 16-bit number, MSB first
-        /*8*/ddpUdp.write(0xFF & (packetSize >> 8));
-        /*9*/ddpUdp.write(0xFF & (packetSize     ));
-
-        // write the colors, the write write(const uint8_t *buffer, size_t size)
-        // function is just a loop internally too
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        packet[8] = 0xFF & (packetSize >> 8);
+        packet[9] = 0xFF & (packetSize     );
+
+        // write the colors
+        scaleChannels(packet + DDP_HEADER_LEN, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
 
-        if (!ddpUdp.endPacket()) {
+        if (!broadcastUdp.beginPacket(client, DDP_DEFAULT_PORT)) {  // port defined in ESPAsyncE131.h
+          //DEBUG_PRINTLN(F("WiFiUDP.beginPacket returned an error"));
+          return 1; // problem
+        }
+        broadcastUdp.write(packet, DDP_HEADER_LEN + packetSize);
+        if (!broadcastUdp.endPacket()) {
           //DEBUG_PRINTLN(F("WiFiUDP.endPacket returned an error"));
           return 1; // problem
         }
@@ -825,6 +923,72 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
     case 1: //E1.31
     {
+      // calculate the number of UDP packets we need to send, 1 packet per universe
+      const size_t channelCount = length * (isRGBW?4:3); // 1 channel for every R,G,B,(W?) value
+      const size_t E131_CHANNELS_PER_PACKET = isRGBW?512:510; // 512/4=128 RGBW LEDs, 510/3=170 RGB LEDs
+      const size_t packetCount = ((channelCount-1)/E131_CHANNELS_PER_PACKET)+1;
+
+      size_t bufferOffset = 0;
+
+      // packet buffer is owned by the bus, its header only needs to be set up once
+      e131_packet_t *e131 = reinterpret_cast<e131_packet_t*>(packet);
+      if (memcmp_P(e131->acn_id, E131_ACN_ID, sizeof(e131->acn_id))) initE131Header(e131);
+      e131->priority = priority;
+      e131->reserved = htons(syncUniverse); // synchronization address
+      e131->sequence_number++; // per source & universe, all universes of a frame share it
+
+      for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
+        size_t packetSize = E131_CHANNELS_PER_PACKET;
+
+        if (currentPacket == (packetCount - 1U)) {
+          // last packet
+          if (channelCount % E131_CHANNELS_PER_PACKET) {
+            packetSize = channelCount % E131_CHANNELS_PER_PACKET;
+          }
+        }
+
+        const uint16_t packetUniverse = universe + currentPacket;
+        const size_t totalSize = E131_HEADER_SIZE + packetSize;
+        // PDU lengths are counted from start of the layer to end of packet, upper 4 bits are flags (0x7)
+        e131->root_flength  = htons(0x7000 | (totalSize - E131_ROOT_FLENGTH));
+        e131->frame_flength = htons(0x7000 | (totalSize - E131_FRAME_FLENGTH));
+        e131->dmp_flength   = htons(0x7000 | (totalSize - E131_DMP_FLENGTH));
+        e131->universe      = htons(packetUniverse);
+        e131->property_value_count = htons(packetSize + 1); // including start code
+
+        scaleChannels(packet + E131_HEADER_SIZE, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
+
+        if (!broadcastUdp.beginPacket(e131Destination(client, packetUniverse), E131_DEFAULT_PORT)) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.beginPacket returned an error"));
+          return 1; // borked
+        }
+        broadcastUdp.write(packet, totalSize);
+        if (!broadcastUdp.endPacket()) {
+          DEBUG_PRINTLN(F("E1.31 WiFiUDP.endPacket returned an error"));
+          return 1; // borked
+        }
+      }
+
+      if (syncUniverse) {
+        // synchronization packet: root layer of data packet (with different vector) followed by sync framing layer
+        uint8_t sync[E131_SYNC_SIZE];
+        memcpy(sync, packet, E131_FRAME_FLENGTH);
+        sync[E131_ROOT_FLENGTH]   = 0x70;
+        sync[E131_ROOT_FLENGTH+1] = E131_SYNC_SIZE - E131_ROOT_FLENGTH;
+        sync[E131_ROOT_VECTOR+3]  = 0x08; // VECTOR_ROOT_E131_EXTENDED
+        sync[E131_FRAME_FLENGTH]   = 0x70;
+        sync[E131_FRAME_FLENGTH+1] = E131_SYNC_SIZE - E131_FRAME_FLENGTH;
+        sync[40] = 0x00; sync[41] = 0x00; sync[42] = 0x00; sync[43] = 0x01; // VECTOR_E131_EXTENDED_SYNCHRONIZATION
+        sync[44] = e131->sequence_number;
+        sync[45] = syncUniverse >> 8;
+        sync[46] = syncUniverse & 0xFF;
+        sync[47] = sync[48] = 0x00; // reserved
+        if (broadcastUdp.beginPacket(e131Destination(client, syncUniverse), E131_DEFAULT_PORT)) {
+          broadcastUdp.write(sync, E131_SYNC_SIZE);
+          broadcastUdp.endPacket();
+        }
+      }
     } break;
 
     case 2: //ArtNet
@@ -839,15 +1003,15 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
 
       sequenceNumber++;
 
+      // header fields that do not change between packets
+      memcpy_P(packet, ART_NET_HEADER, ART_NET_HEADER_SIZE); // Hard coded ID, OpCode, and protocol version.
+      packet[13] = 0x00; // physical - more an FYI, not really used for anything. 0..3
+      packet[15] = 0x00; // Universe MSB, unused.
+
       for (size_t currentPacket = 0; currentPacket < packetCount; currentPacket++) {
 
         if (sequenceNumber > 255) sequenceNumber = 0;
 
-        if (!ddpUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
-          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
-          return 1; // borked
-        }
-
         size_t packetSize = ARTNET_CHANNELS_PER_PACKET;
 
         if (currentPacket == (packetCount - 1U)) {
@@ -857,24 +1021,20 @@ uint8_t realtimeBroadcast(uint8_t type, IPAddress client, uint16_t length, const
           }
         }
 
-        byte header_buffer[ART_NET_HEADER_SIZE];
-        memcpy_P(header_buffer, ART_NET_HEADER, ART_NET_HEADER_SIZE);
-        ddpUdp.write(header_buffer, ART_NET_HEADER_SIZE); // This doesn't change. Hard coded ID, OpCode, and protocol version.
-        ddpUdp.write(sequenceNumber & 0xFF); // sequence number. 1..255
-        ddpUdp.write(0x00); // physical - more an FYI, not really used for anything. 0..3
-        ddpUdp.write((currentPacket) & 0xFF); // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
-        ddpUdp.write(0x00); // Universe MSB, unused.
-        ddpUdp.write(0xFF & (packetSize >> 8)); // 16-bit length of channel data, MSB
-        ddpUdp.write(0xFF & (packetSize     )); // 16-bit length of channel data, LSB
-
-        for (size_t i = 0; i < packetSize; i += (isRGBW?4:3)) {
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // R
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // G
-          ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // B
-          if (isRGBW) ddpUdp.write(scale8(buffer[bufferOffset++], bri)); // W
-        }
+        packet[12] = sequenceNumber & 0xFF; // sequence number. 1..255
+        packet[14] = (currentPacket) & 0xFF; // Universe LSB. 1 full packet == 1 full universe, so just use current packet number.
+        packet[16] = 0xFF & (packetSize >> 8); // 16-bit length of channel data, MSB
+        packet[17] = 0xFF & (packetSize     ); // 16-bit length of channel data, LSB
+
+        scaleChannels(packet + ART_NET_DMX_HEADER_SIZE, buffer + bufferOffset, packetSize, bri);
+        bufferOffset += packetSize;
 
-        if (!ddpUdp.endPacket()) {
+        if (!broadcastUdp.beginPacket(client, ARTNET_DEFAULT_PORT)) {
+          DEBUG_PRINTLN(F("Art-Net WiFiUDP.beginPacket returned an error"));
+          return 1; // borked
+        }
+        broadcastUdp.write(packet, ART_NET_DMX_HEADER_SIZE + packetSize);
+        if (!broadcastUdp.endPacket()) {
           DEBUG_PRINTLN(F("Art-Net WiFiUDP.endPacket returned an error"));
           return 1; // borked
         }
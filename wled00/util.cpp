@@ -2,6 +2,7 @@
 #include "fcn_declare.h"
 #include "const.h"
 #include "src/dependencies/fastled_slim/fastled_slim.h"
+#include <atomic>
 #ifdef ESP8266
 #include "user_interface.h" // for bootloop detection
 #include <Hash.h>            // for SHA1 on ESP8266
@@ -269,6 +270,13 @@ static SemaphoreHandle_t jsonBufferLockMutex = xSemaphoreCreateRecursiveMutex();
 #endif
 static volatile uint8_t jsonBufferLock = 0;
 
+static struct {
+  uint32_t locks;                         // global JSON buffer locks acquired
+  uint32_t fails[JSON_LOCK_MODULES];      // failed lock requests per module (buffer was in use)
+  uint32_t poolHits;                      // documents served from pool
+  uint32_t poolMisses;                    // pool exhausted, caller fell back to global JSON buffer
+} jsonStats;
+
 //threading/network callback details: https://github.com/wled-dev/WLED/pull/2336#discussion_r762276994
 bool requestJSONBufferLock(uint8_t moduleID)
 {
@@ -294,6 +302,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
 #endif  
   // If the lock is still held - by us, or by another task
   if (jsonBufferLock) {
+    jsonStats.fails[moduleID < JSON_LOCK_MODULES ? moduleID : 0]++;
     DEBUG_PRINTF_P(PSTR("ERROR: Locking JSON buffer (%d) failed! (still locked by %d)\n"), moduleID, jsonBufferLock);
 #ifdef ARDUINO_ARCH_ESP32
     xSemaphoreGiveRecursive(jsonBufferLockMutex);
@@ -302,6 +311,7 @@ bool requestJSONBufferLock(uint8_t moduleID)
   }
 
   jsonBufferLock = moduleID ? moduleID : 255;
+  jsonStats.locks++;
   DEBUG_PRINTF_P(PSTR("JSON buffer locked. (%d)\n"), jsonBufferLock);
   pDoc->clear();
   return true;
@@ -317,6 +327,90 @@ void releaseJSONBufferLock()
 #endif  
 }
 
+// Pool of additional JSON documents for serializing state/info (HTTP JSON GET, WebSocket updates).
+// Documents only hold one part of the state (see serializeStatePart()) and are allocated on first use (in PSRAM if
+// available), DRAM documents are freed again if heap runs low. If no document is available callers fall back to
+// requestJSONBufferLock() and pDoc.
+// Each document is claimed with an atomic owner slot, independent of the global JSON buffer lock, so readers and
+// preset/state changes do not wait for each other. Readers must not access segments while they are being changed:
+// wrap each serialized part in strip.beginStateRead()/strip.endStateRead() (deserializeState() etc. suspend the strip
+// and waitForIt() also waits for readers).
+#if WLED_JSON_POOL_SIZE > 0
+static PSRAMDynamicJsonDocument *jsonPool[WLED_JSON_POOL_SIZE] = {nullptr};
+static std::atomic<uint8_t> jsonPoolOwner[WLED_JSON_POOL_SIZE]; // module ID, 0 if free
+#endif
+
+JsonDocument *requestJSONDocument(uint8_t moduleID)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    uint8_t owner = 0;
+    if (!jsonPoolOwner[i].compare_exchange_strong(owner, moduleID ? moduleID : 255)) continue; // in use
+    if (!jsonPool[i]) {
+      #if defined(BOARD_HAS_PSRAM)
+      if (psramFound()) jsonPool[i] = new(std::nothrow) PSRAMDynamicJsonDocument(JSON_POOL_DOC_SIZE);
+      else
+      #endif
+      if (getContiguousFreeHeap() > JSON_POOL_DOC_SIZE + 2*MIN_HEAP_SIZE) jsonPool[i] = new(std::nothrow) PSRAMDynamicJsonDocument(JSON_POOL_DOC_SIZE);
+      if (jsonPool[i] && jsonPool[i]->capacity() == 0) { // allocation of document memory failed
+        delete jsonPool[i];
+        jsonPool[i] = nullptr;
+      }
+    }
+    if (!jsonPool[i]) {
+      jsonPoolOwner[i] = 0;
+      break; // not enough memory for another document
+    }
+    jsonStats.poolHits++;
+    DEBUG_PRINTF_P(PSTR("JSON document %u taken. (%d)\n"), i, moduleID);
+    jsonPool[i]->clear();
+    return jsonPool[i];
+  }
+  jsonStats.poolMisses++;
+#endif
+  return nullptr;
+}
+
+void releaseJSONDocument(JsonDocument *doc)
+{
+#if WLED_JSON_POOL_SIZE > 0
+  for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) {
+    if (jsonPool[i] != doc) continue;
+    DEBUG_PRINTF_P(PSTR("JSON document %u released. (%d)\n"), i, jsonPoolOwner[i].load());
+    #if defined(BOARD_HAS_PSRAM)
+    if (!psramFound())
+    #endif
+    if (getContiguousFreeHeap() < 2*MIN_HEAP_SIZE) { // give DRAM back if heap is running low
+      delete jsonPool[i];
+      jsonPool[i] = nullptr;
+    }
+    jsonPoolOwner[i] = 0;
+    return;
+  }
+#endif
+}
+
+// {"locks":n,"pool":[size,hits,misses],"fail":[[module,count],...]}
+void serializeJSONBufferStats(JsonObject root)
+{
+  root[F("locks")] = jsonStats.locks;
+  JsonArray pool = root.createNestedArray(F("pool"));
+  unsigned allocated = 0;
+  #if WLED_JSON_POOL_SIZE > 0
+  for (unsigned i = 0; i < WLED_JSON_POOL_SIZE; i++) if (jsonPool[i]) allocated++;
+  #endif
+  pool.add(allocated);
+  pool.add(jsonStats.poolHits);
+  pool.add(jsonStats.poolMisses);
+  JsonArray fails = root.createNestedArray(F("fail"));
+  for (unsigned i = 0; i < JSON_LOCK_MODULES; i++) {
+    if (!jsonStats.fails[i]) continue;
+    JsonArray f = fails.createNestedArray();
+    f.add(i ? i : JSON_LOCK_UNKNOWN);
+    f.add(jsonStats.fails[i]);
+  }
+}
+
 
 // extracts effect mode (or palette) name from names serialized string
 // caller must provide large enough buffer for name (including SR extensions)! maxLen is (buffersize - 1)
@@ -692,7 +786,7 @@ um_data_t* simulateSound(uint8_t simulationId)
 }
 
 static const char s_ledmap_tmpl[] PROGMEM = "ledmap%d.json";
-// enumerate all ledmapX.json files on FS and extract ledmap names if existing
+// enumerate all ledmapX.json (or binary ledmapX.bin) files on FS and extract ledmap names if existing
 void enumerateLedmaps() {
   StaticJsonDocument<64> filter;
   filter["n"] = true;
@@ -700,7 +794,14 @@ void enumerateLedmaps() {
   for (size_t i=1; i<WLED_MAX_LEDMAPS; i++) {
     char fileName[33] = "/";
     sprintf_P(fileName+1, s_ledmap_tmpl, i);
-    bool isFile = WLED_FS.exists(fileName);
+    bool isJson = WLED_FS.exists(fileName);
+    bool isFile = isJson;
+    if (!isFile) {
+      char binName[33];
+      strcpy(binName, fileName);
+      strcpy_P(strrchr(binName, '.'), PSTR(".bin"));
+      isFile = WLED_FS.exists(binName);
+    }
 
     #ifndef ESP8266
     if (ledmapNames[i-1]) { //clear old name
@@ -714,10 +815,10 @@ void enumerateLedmaps() {
 
       #ifndef ESP8266
       if (requestJSONBufferLock(JSON_LOCK_LEDMAP_ENUM)) {
-        if (readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
+        if (!isJson || readObjectFromFile(fileName, nullptr, pDoc, &filter)) {
           size_t len = 0;
           JsonObject root = pDoc->as<JsonObject>();
-          if (!root["n"].isNull()) {
+          if (isJson && !root["n"].isNull()) {
             // name field exists
             const char *name = root["n"].as<const char*>();
             if (name != nullptr) len = strlen(name);
@@ -742,6 +843,14 @@ void enumerateLedmaps() {
   }
 }
 
+// removes binary ledmap generated from ledmapX.json when the JSON file is replaced or deleted (see WS2812FX::deserializeMap())
+void invalidateLedmapCache(const String &fileName) {
+  if (fileName.indexOf(F("ledmap")) < 0 || !fileName.endsWith(F(".json"))) return;
+  String binName = fileName.substring(0, fileName.length() - 5) + F(".bin");
+  if (binName.charAt(0) != '/') binName = '/' + binName;
+  if (WLED_FS.exists(binName)) WLED_FS.remove(binName);
+}
+
 /*
  * Returns a new, random color wheel index with a minimum distance of 42 from pos.
  */
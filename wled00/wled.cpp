@@ -250,6 +250,9 @@ void WLED::loop()
     strip.deserializeMap(loadLedmap);
     loadLedmap = -1;
   }
+  #ifdef WLED_ENABLE_FX_BENCHMARK
+  handleFxBenchmark();
+  #endif
   yield();
   if (configNeedsWrite) serializeConfigToFS();
 
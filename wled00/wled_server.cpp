@@ -216,7 +216,11 @@ static void handleUpload(AsyncWebServerRequest *request, const String& filename,
 
     request->_tempFile = WLED_FS.open(finalname, "w");
     DEBUG_PRINTF_P(PSTR("Uploading %s\n"), finalname.c_str());
-    if (finalname.equals(FPSTR(getPresetsFileName()))) presetsModifiedTime = toki.second();
+    if (finalname.equals(FPSTR(getPresetsFileName()))) {
+      presetsModifiedTime = toki.second();
+      invalidatePresetIndex();
+    }
+    invalidateLedmapCache(finalname);
   }
   if (len) {
     request->_tempFile.write(data,len);
@@ -319,8 +323,10 @@ static void createEditHandler() {
     if (func == "delete") {
       if (!WLED_FS.remove(path))
         request->send(500, FPSTR(CONTENT_TYPE_PLAIN), F("Delete failed"));
-      else
+      else {
+        invalidateLedmapCache(path);
         request->send(200, FPSTR(CONTENT_TYPE_PLAIN), F("File deleted"));
+      }
       updateFSInfo(); // refresh memory usage info
       return;
     }
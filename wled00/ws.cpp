@@ -1,4 +1,5 @@
 #include "wled.h"
+#include <StreamString.h>
 
 /*
  * WebSockets server for bidirectional communication
@@ -19,6 +20,69 @@ static unsigned long wsLastLiveTime = 0;
 //static uint8_t* wsFrameBuffer = nullptr;
 
 #define WS_LIVE_INTERVAL 40
+#define WS_LIVE_MAX_INTERVAL 320 // live view back-off while the client queue does not drain
+#define WS_LIVE_KEY_FRAMES 50    // v3: send a complete frame every n frames
+#ifdef ESP8266
+#define WS_LIVE3_MAX_LEDS 1024   // ESP32: limited by MAX_LEDS and free heap, see sendLiveLeds3()
+#endif
+
+static unsigned wsLiveInterval = WS_LIVE_INTERVAL; // adapted to client queue in handleWs()
+
+// live view v3 (full resolution, RLE + delta to previous frame), requested with {"lv":3}
+static uint8_t  wsLiveVersion = 1;       // 1 = v1/v2 frames, 3 = v3 frames
+static bool     wsLiveRGB565  = false;   // v3: 16 bit colors, requested with {"lv":3,"rgb565":true}
+static uint8_t *wsLivePrev    = nullptr; // v3: frame as known to the client (RGB)
+static uint8_t *wsLiveBuf     = nullptr; // v3: encoded frame
+static size_t   wsLiveLen     = 0;       // v3: pixels in wsLivePrev
+static unsigned wsLiveFrames  = 0;       // v3: frames since last key frame (0 = send key frame)
+static size_t   wsLiveNoMem   = 0;       // v3: pixels for which buffers could not be allocated (not retried every frame)
+
+#define WS_MAX_DELTA_CLIENTS 4 // clients receiving delta state updates (see serializeStateDelta())
+
+static uint32_t wsDeltaClients[WS_MAX_DELTA_CLIENTS] = {0}; // client IDs, 0 = unused
+static bool wsDeltaReset = true; // next delta has to contain complete state
+
+static bool isDeltaClient(uint32_t id)
+{
+  for (auto c : wsDeltaClients) if (c == id) return true;
+  return false;
+}
+
+static void setDeltaClient(uint32_t id, bool enable)
+{
+  for (auto &c : wsDeltaClients) if (c == id) c = 0;
+  if (!enable) return;
+  for (auto &c : wsDeltaClients) if (!c) { c = id; wsDeltaReset = true; return; } // new client needs complete state
+}
+
+// number of connected delta clients, forgets disconnected ones
+static unsigned countDeltaClients()
+{
+  unsigned n = 0;
+  for (auto &c : wsDeltaClients) {
+    if (c && !ws.client(c)) c = 0;
+    if (c) n++;
+  }
+  return n;
+}
+
+static void freeLiveBuffers()
+{
+  p_free(wsLivePrev);
+  p_free(wsLiveBuf);
+  wsLivePrev = nullptr;
+  wsLiveBuf  = nullptr;
+  wsLiveLen  = 0;
+}
+
+static void setLiveClient(uint16_t id, uint8_t version, bool rgb565 = false)
+{
+  wsLiveClientId = id;
+  wsLiveVersion  = version;
+  wsLiveRGB565   = rgb565;
+  wsLiveFrames   = 0; // new client needs a key frame (buffers are released in handleWs(), they may be in use)
+  wsLiveNoMem    = 0; // try to allocate again
+}
 
 void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventType type, void * arg, uint8_t *data, size_t len)
 {
@@ -28,7 +92,8 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
     sendDataWs(client);
   } else if(type == WS_EVT_DISCONNECT){
     //client disconnected
-    if (client->id() == wsLiveClientId) wsLiveClientId = 0;
+    if (client->id() == wsLiveClientId) setLiveClient(0, 1);
+    setDeltaClient(client->id(), false);
     DEBUG_PRINTLN(F("WS client disconnected."));
   } else if(type == WS_EVT_DATA){
     // data packet
@@ -60,7 +125,13 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
           //if the received value is just "{"v":true}", send only to this client
           verboseResponse = true;
         } else if (root.containsKey("lv")) {
-          wsLiveClientId = root["lv"] ? client->id() : 0;
+          // {"lv":true} v1/v2 frames, {"lv":3} v3 frames (optional "rgb565":true), {"lv":false} stop
+          JsonVariant lv = root["lv"];
+          setLiveClient(lv ? client->id() : 0, lv.is<int>() && lv.as<int>() >= 3 ? 3 : 1, root[F("rgb565")] | false);
+        } else if (root.containsKey(F("delta"))) {
+          // {"delta":true} opt in to delta updates (or request resync), {"delta":false} receive complete state again
+          setDeltaClient(client->id(), root[F("delta")].as<bool>());
+          verboseResponse = true;
         } else {
           verboseResponse = deserializeState(root);
         }
@@ -130,11 +201,78 @@ void wsEvent(AsyncWebSocket * server, AsyncWebSocketClient * client, AwsEventTyp
   }
 }
 
+#define WS_FRAME_MARGIN 128 // allowed growth of state/info frame between updates before it has to be generated twice
+
+// Print adapter writing into a fixed size buffer, counts bytes beyond its size
+class BufferPrint : public Print {
+  uint8_t *_buf;
+  size_t _size, _len = 0;
+  public:
+  BufferPrint(uint8_t *buf, size_t size) : _buf(buf), _size(size) {}
+  size_t write(uint8_t c) override { if (_len < _size) _buf[_len] = c; _len++; return 1; }
+  size_t write(const uint8_t *buf, size_t size) override {
+    if (_len < _size) memcpy(_buf + _len, buf, min(size, _size - _len));
+    _len += size;
+    return size;
+  }
+};
+
+// release document taken by sendDataWs()
+static void releaseJSONDoc(JsonDocument *doc)
+{
+  if (doc == pDoc) releaseJSONBufferLock();
+  else {
+    strip.endStateRead();
+    releaseJSONDocument(doc);
+  }
+}
+
+// pooled document (segments may be read until it is released) or global JSON buffer, nullptr if neither is available
+static JsonDocument *requestJSONDoc()
+{
+  JsonDocument *doc = requestJSONDocument(JSON_LOCK_WS_SEND); // keeps the global JSON buffer free for presets/state changes
+  if (doc && !strip.beginStateRead()) { // segments are being changed
+    releaseJSONDocument(doc);
+    doc = nullptr;
+  }
+  if (!doc && requestJSONBufferLock(JSON_LOCK_WS_SEND)) doc = pDoc;
+  return doc;
+}
+
+// part of state did not fit into pooled document: continue with global JSON buffer, nullptr if not available
+static JsonDocument *fallbackJSONDoc(JsonDocument *doc)
+{
+  releaseJSONDoc(doc);
+  return doc != pDoc && requestJSONBufferLock(JSON_LOCK_WS_SEND) ? pDoc : nullptr;
+}
+
+// send delta update to all clients that opted in, returns false if doc was too small
+static bool sendDeltaWs(JsonDocument *doc)
+{
+  StreamString out;
+  size_t len = serializeStateDelta(out, *doc, wsDeltaReset);
+  if (len == JSON_STREAM_OVERFLOW) return false;
+  if (!len) return true; // nothing changed
+  wsDeltaReset = false;
+  DEBUG_PRINTF_P(PSTR("Sending WS delta (%u bytes).\n"), out.length());
+  for (auto c : wsDeltaClients) {
+    AsyncWebSocketClient *wsc = c ? ws.client(c) : nullptr;
+    if (wsc) wsc->text(out.c_str(), out.length());
+  }
+  return true;
+}
+
 void sendDataWs(AsyncWebSocketClient * client)
 {
   if (!ws.count()) return;
 
-  if (!requestJSONBufferLock(JSON_LOCK_WS_SEND)) {
+  // delta clients ignore complete state frames, a complete frame for them means a delta broadcast
+  unsigned deltaClients = countDeltaClients();
+  bool sendDelta = deltaClients && (!client || isDeltaClient(client->id()));
+  bool sendFull  = client ? !sendDelta : ws.count() > deltaClients;
+
+  JsonDocument *doc = requestJSONDoc();
+  if (!doc) {
     const char* error = PSTR("{\"error\":3}");
     if (client) {
       client->text(FPSTR(error)); // ERR_NOBUF
@@ -144,43 +282,202 @@ void sendDataWs(AsyncWebSocketClient * client)
     return;
   }
 
-  JsonObject state = pDoc->createNestedObject("state");
-  serializeState(state);
-  JsonObject info  = pDoc->createNestedObject("info");
-  serializeInfo(info);
-
-  size_t len = measureJson(*pDoc);
-  DEBUG_PRINTF_P(PSTR("JSON buffer size: %u for WS request (%u).\n"), pDoc->memoryUsage(), len);
-
-  // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
-  size_t heap1 = getFreeHeapSize();
-  DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
-  AsyncWebSocketBuffer buffer(len);
-  #ifdef ESP8266
-  size_t heap2 = getFreeHeapSize();
-  DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
-  #else
-  size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
-  #endif
-  if (!buffer || heap1-heap2<len) {
-    releaseJSONBufferLock();
-    DEBUG_PRINTLN(F("WS buffer allocation failed."));
-    ws.closeAll(1013); //code 1013 = temporary overload, try again later
-    ws.cleanupClients(0); //disconnect all clients to release memory
-    return; //out of memory
+  const byte err = errorFlag; // serializeState() clears errorFlag, restore it if state has to be generated again
+  if (sendDelta) while (true) {
+    errorFlag = err;
+    if (sendDeltaWs(doc)) break;
+    if (!(doc = fallbackJSONDoc(doc))) return;
+  }
+  if (!sendFull) {
+    releaseJSONDoc(doc);
+    return;
   }
-  serializeJson(*pDoc, (char *)buffer.data(), len);
 
-  DEBUG_PRINT(F("Sending WS data "));
-  if (client) {
-    DEBUG_PRINTLN(F("to a single client."));
-    client->text(std::move(buffer));
-  } else {
-    DEBUG_PRINTLN(F("to multiple clients."));
-    ws.textAll(std::move(buffer));
+  // frame size has to be known before serializing: use size of previous frame plus a margin and pad the remainder
+  // with spaces (JSON whitespace), state is streamed segment by segment directly into the frame (no copy)
+  static size_t frameSize = 0;
+  for (unsigned attempt = 0; attempt < 3; attempt++) {
+    size_t size = frameSize + WS_FRAME_MARGIN;
+    // the following may no longer be necessary as heap management has been fixed by @willmmiles in AWS
+    size_t heap1 = getFreeHeapSize();
+    DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+    AsyncWebSocketBuffer buffer(size);
+    #ifdef ESP8266
+    size_t heap2 = getFreeHeapSize();
+    DEBUG_PRINTF_P(PSTR("heap %u\n"), getFreeHeapSize());
+    #else
+    size_t heap2 = 0; // ESP32 variants do not have the same issue and will work without checking heap allocation
+    #endif
+    if (!buffer || heap1-heap2<size) {
+      releaseJSONDoc(doc);
+      DEBUG_PRINTLN(F("WS buffer allocation failed."));
+      ws.closeAll(1013); //code 1013 = temporary overload, try again later
+      ws.cleanupClients(0); //disconnect all clients to release memory
+      return; //out of memory
+    }
+    uint8_t *data = reinterpret_cast<uint8_t*>(buffer.data());
+    BufferPrint out(data, size);
+    errorFlag = err;
+    size_t len = serializeStateStream(out, *doc);
+    if (len == JSON_STREAM_OVERFLOW) {
+      if (!(doc = fallbackJSONDoc(doc))) return;
+      continue;
+    }
+    frameSize = len;
+    DEBUG_PRINTF_P(PSTR("WS frame: %u/%u bytes.\n"), frameSize, size);
+    if (frameSize > size) continue; // did not fit, retry with actual size
+    memset(data + frameSize, ' ', size - frameSize);
+    releaseJSONDoc(doc);
+
+    DEBUG_PRINT(F("Sending WS data "));
+    if (client) {
+      DEBUG_PRINTLN(F("to a single client."));
+      client->text(std::move(buffer));
+    } else {
+      DEBUG_PRINTLN(F("to multiple clients.")); // also received (and ignored) by delta clients
+      ws.textAll(std::move(buffer));
+    }
+    return;
+  }
+  releaseJSONDoc(doc); // state kept growing between attempts, skip this update
+}
+
+// RGB as shown in live view, white channel is added to RGB channels as a simple RGBW -> RGB map
+static inline uint32_t liveColor(unsigned i)
+{
+  if (!bri) return 0;
+  uint32_t c = strip.getPixelColor(i); // note: LEDs mapped outside of valid range are set to black
+  uint8_t w = W(c);
+  return RGBW32(qadd8(w, R(c)), qadd8(w, G(c)), qadd8(w, B(c)), 0);
+}
+
+/*
+ * Live view v3: full resolution frame, run-length encoded and (except for key frames) relative to the previous one
+ * header: 'L', 3, flags (bit 0: delta frame, bit 1: RGB565), width (16 bit BE), height (16 bit BE)
+ * runs:   0b1nnnnnnn                 n+1 pixels unchanged since previous frame (delta frames only)
+ *         0b01nnnnnn <color>         n+1 pixels of the same color
+ *         0b00nnnnnn <color>...      n+1 pixels, one color each
+ * color:  RGB (3 bytes) or RGB565 (2 bytes BE)
+ * Pixels missing at the end of a delta frame are unchanged. Encoding uses a preallocated buffer, only
+ * the compressed frame is copied for sending. Returns false if v3 can't be served (use v1/v2 instead).
+ */
+static bool sendLiveLeds3(AsyncWebSocketClient *wsc)
+{
+  size_t width  = strip.getLengthTotal();
+  size_t height = 1;
+#ifndef WLED_DISABLE_2D
+  if (strip.isMatrix) {
+    width  = Segment::maxWidth; // ignore anything behind matrix (i.e. extra strip)
+    height = Segment::maxHeight;
   }
+#endif
+  const size_t used = width * height;
+#ifdef ESP8266
+  if (used > WS_LIVE3_MAX_LEDS) return false;
+#endif
+  if (used == 0 || used > MAX_LEDS || used == wsLiveNoMem) return false;
+
+  constexpr size_t headerSize = 7;
+  if (used != wsLiveLen) {
+    freeLiveBuffers();
+    wsLivePrev = static_cast<uint8_t*>(p_malloc(used * 3));
+    wsLiveBuf  = static_cast<uint8_t*>(p_malloc(headerSize + used * 3 + used / 64 + 1)); // worst case: literal runs only
+    // buffers are in DRAM without PSRAM (~6 bytes per LED, 48kB for 128x64): the copy of each frame for sending
+    // comes from the same heap, keep room for a key frame compressed to half its size (frames are skipped otherwise)
+    bool heapOk = true;
+#if defined(ARDUINO_ARCH_ESP32) && defined(BOARD_HAS_PSRAM)
+    if (!psramFound())
+#endif
+    heapOk = getContiguousFreeHeap() >= used * 3 / 2 + MIN_HEAP_SIZE;
+    if (!wsLivePrev || !wsLiveBuf || !heapOk) {
+      DEBUG_PRINTF_P(PSTR("Live view v3: not enough memory for %u LEDs\n"), (unsigned)used);
+      freeLiveBuffers();
+      wsLiveNoMem = used; // v1/v2 frames until geometry or live client changes
+      return false;
+    }
+    wsLiveLen    = used;
+    wsLiveFrames = 0;
+  }
+
+  const bool delta = wsLiveFrames > 0;
+  const bool rgb565 = wsLiveRGB565;
+  uint8_t *out = wsLiveBuf;
+  out[0] = 'L';
+  out[1] = 3; // version
+  out[2] = (delta ? 0x01 : 0) | (rgb565 ? 0x02 : 0);
+  out[3] = width >> 8;
+  out[4] = width & 0xFF;
+  out[5] = height >> 8;
+  out[6] = height & 0xFF;
+  size_t pos = headerSize;
+
+  uint32_t runColor = 0;
+  unsigned run  = 0; // pixels of runColor not yet written
+  unsigned skip = 0; // unchanged pixels not yet written
+  unsigned lit  = 0; // pixels in open literal run
+  size_t litPos = 0; // control byte of open literal run
+  auto putColor = [&](uint32_t c) {
+    if (rgb565) {
+      out[pos++] = (R(c) & 0xF8) | (G(c) >> 5);
+      out[pos++] = ((G(c) << 3) & 0xE0) | (B(c) >> 3);
+    } else {
+      out[pos++] = R(c);
+      out[pos++] = G(c);
+      out[pos++] = B(c);
+    }
+  };
+  auto flushRun = [&]() {
+    if (run == 1) {
+      if (lit == 0 || lit == 64) { litPos = pos++; lit = 0; }
+      out[litPos] = lit++;
+      putColor(runColor);
+    } else if (run > 1) {
+      out[pos++] = 0x40 | (run - 1);
+      putColor(runColor);
+      lit = 0;
+    }
+    run = 0;
+  };
+  auto flushSkip = [&]() {
+    if (!skip) return;
+    out[pos++] = 0x80 | (skip - 1);
+    skip = 0;
+    lit  = 0;
+  };
+
+  for (size_t i = 0; i < used; i++) {
+    uint32_t c = liveColor(i);
+    if (rgb565) c &= 0xF8FCF8; // compare what the client sees
+    uint8_t *p = wsLivePrev + i * 3;
+    if (delta && p[0] == R(c) && p[1] == G(c) && p[2] == B(c)) {
+      flushRun();
+      if (++skip == 128) flushSkip();
+      continue;
+    }
+    p[0] = R(c);
+    p[1] = G(c);
+    p[2] = B(c);
+    flushSkip();
+    if (run && run < 64 && c == runColor) run++;
+    else {
+      flushRun();
+      runColor = c;
+      run = 1;
+    }
+  }
+  flushRun(); // trailing unchanged pixels are implied
+
+  if (++wsLiveFrames >= WS_LIVE_KEY_FRAMES) wsLiveFrames = 0;
+  if (pos == headerSize) return true; // nothing changed
 
-  releaseJSONBufferLock();
+  AsyncWebSocketBuffer wsBuf(pos);
+  if (!wsBuf) {
+    wsLiveFrames = 0; // client and wsLivePrev are out of sync
+    return true;
+  }
+  memcpy(wsBuf.data(), out, pos);
+  wsc->binary(std::move(wsBuf));
+  return true;
 }
 
 static bool sendLiveLedsWs(uint32_t wsClient)
@@ -188,6 +485,8 @@ static bool sendLiveLedsWs(uint32_t wsClient)
   AsyncWebSocketClient * wsc = ws.client(wsClient);
   if (!wsc || wsc->queueLength() > 0) return false; //only send if queue free
 
+  if (wsLiveVersion >= 3 && sendLiveLeds3(wsc)) return true;
+
   size_t used = strip.getLengthTotal();
 #ifdef ESP8266
   const size_t MAX_LIVE_LEDS_WS = 256U;
@@ -228,14 +527,10 @@ static bool sendLiveLedsWs(uint32_t wsClient)
 #ifndef WLED_DISABLE_2D
     if (strip.isMatrix && n>1 && (i/Segment::maxWidth)%n) i += Segment::maxWidth * (n-1);
 #endif
-    uint32_t c = strip.getPixelColor(i); // note: LEDs mapped outside of valid range are set to black
-    uint8_t r = R(c);
-    uint8_t g = G(c);
-    uint8_t b = B(c);
-    uint8_t w = W(c);
-    buffer[pos++] = bri ? qadd8(w, r) : 0; //R, add white channel to RGB channels as a simple RGBW -> RGB map
-    buffer[pos++] = bri ? qadd8(w, g) : 0; //G
-    buffer[pos++] = bri ? qadd8(w, b) : 0; //B
+    uint32_t c = liveColor(i);
+    buffer[pos++] = R(c);
+    buffer[pos++] = G(c);
+    buffer[pos++] = B(c);
   }
 
   wsc->binary(std::move(wsBuf));
@@ -244,7 +539,7 @@ static bool sendLiveLedsWs(uint32_t wsClient)
 
 void handleWs()
 {
-  if (millis() - wsLastLiveTime > WS_LIVE_INTERVAL)
+  if (millis() - wsLastLiveTime > wsLiveInterval)
   {
     #ifdef ESP8266
     ws.cleanupClients(3);
@@ -253,8 +548,15 @@ void handleWs()
     #endif
     bool success = true;
     if (wsLiveClientId) success = sendLiveLedsWs(wsLiveClientId);
+    if ((!wsLiveClientId || wsLiveVersion < 3) && wsLiveLen) freeLiveBuffers();
     wsLastLiveTime = millis();
-    if (!success) wsLastLiveTime -= 20; //try again in 20ms if failed due to non-empty WS queue
+    // adapt frame rate to the client: back off while its queue does not drain, recover gradually
+    if (!success) {
+      wsLiveInterval = min(wsLiveInterval * 2, (unsigned)WS_LIVE_MAX_INTERVAL);
+      wsLastLiveTime -= wsLiveInterval / 2; // try again sooner than a full interval
+    } else if (wsLiveInterval > WS_LIVE_INTERVAL) {
+      wsLiveInterval -= max((wsLiveInterval - WS_LIVE_INTERVAL) / 8, 1U);
+    }
   }
 }
 
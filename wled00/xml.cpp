@@ -381,6 +381,9 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       char la[4] = "LA"; la[2] = offset+s; la[3] = 0; //LED current
       char ma[4] = "MA"; ma[2] = offset+s; ma[3] = 0; //max per-port PSU current
       char hs[4] = "HS"; hs[2] = offset+s; hs[3] = 0; //hostname (for network types, custom text for others)
+      char eu[4] = "EU"; eu[2] = offset+s; eu[3] = 0; //E1.31 universe
+      char ep[4] = "EP"; ep[2] = offset+s; ep[3] = 0; //E1.31 priority
+      char es[4] = "ES"; es[2] = offset+s; es[3] = 0; //E1.31 sync universe
       settingsScript.print(F("addLEDs(1);"));
       uint8_t pins[OUTPUT_MAX_PINS];
       int nPins = bus->getPins(pins);
@@ -422,6 +425,11 @@ void getSettingsJS(byte subPage, Print& settingsScript)
       printSetFormValue(settingsScript,la,bus->getLEDCurrent());
       printSetFormValue(settingsScript,ma,bus->getMaxCurrent());
       printSetFormValue(settingsScript,hs,bus->getCustomText().c_str());
+      if (bus->getType() == TYPE_NET_E131_RGB) {
+        printSetFormValue(settingsScript,eu,bus->getUniverse());
+        printSetFormValue(settingsScript,ep,bus->getPriority());
+        printSetFormValue(settingsScript,es,bus->getSyncUniverse());
+      }
       sumMa += bus->getMaxCurrent();
     }
     printSetFormValue(settingsScript,PSTR("MA"),BusManager::ablMilliampsMax() ? BusManager::ablMilliampsMax() : sumMa);
@@ -452,6 +460,7 @@ void getSettingsJS(byte subPage, Print& settingsScript)
     printSetFormValue(settingsScript,PSTR("TL"),nightlightDelayMinsDefault);
     printSetFormValue(settingsScript,PSTR("TW"),nightlightMode);
     printSetFormIndex(settingsScript,PSTR("PB"),paletteBlend);
+    printSetFormCheckbox(settingsScript,PSTR("PG"),particleCollisionGrid);
     printSetFormValue(settingsScript,PSTR("RL"),rlyPin);
     printSetFormCheckbox(settingsScript,PSTR("RM"),rlyMde);
     printSetFormCheckbox(settingsScript,PSTR("RO"),rlyOpenDrain);